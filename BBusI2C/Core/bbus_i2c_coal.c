@@ -0,0 +1,214 @@
+/**
+ * @file    bbus_i2c_coal.c
+ * @version v1.0
+ * @date    2026-10-19
+ * @author  ZeroOneLab
+ * @website https://github.com/ZeroOneLab/BBusI2C.git
+ *
+ * @license MIT License
+ * Copyright (c) 2026 ZeroOneLab
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "bbus_i2c_coal.h"
+
+/**
+ * @brief       以 seed 为起点，把后续同一设备上重叠或相邻的请求并入同一次连续读
+ * @param       seed: 起始请求
+ * @param       lo: 返回合并区间的起始寄存器
+ * @param       hi: 返回合并区间的结束寄存器(不含)
+ * @retval      无
+ */
+static void bbus_i2c_coal_group(bbus_i2c_coal_req_t *seed, uint32_t *lo, uint32_t *hi)
+{
+    uint8_t grown;
+
+    seed->state = BBUS_I2C_COAL_GROUPED;
+    *lo = seed->reg_address;
+    *hi = *lo + seed->len;
+    if (*hi - *lo > BBUS_I2C_COAL_MAX_BURST)
+    {
+        return; // 单个请求已超过合并上限，单独读取
+    }
+    do
+    {
+        grown = 0;
+        for (bbus_i2c_coal_req_t *r = seed->next; r; r = r->next)
+        {
+            uint32_t r_lo = r->reg_address, r_hi = r_lo + r->len;
+            uint32_t new_lo = r_lo < *lo ? r_lo : *lo;
+            uint32_t new_hi = r_hi > *hi ? r_hi : *hi;
+
+            if (r->state != BBUS_I2C_COAL_PENDING || r->dev != seed->dev || r_lo > *hi || r_hi < *lo ||
+                new_hi - new_lo > BBUS_I2C_COAL_MAX_BURST)
+            {
+                continue;
+            }
+            r->state = BBUS_I2C_COAL_GROUPED;
+            *lo = new_lo;
+            *hi = new_hi;
+            grown = 1;
+        }
+    } while (grown);
+}
+
+/**
+ * @brief       完成一个请求：先置为完成状态，再调用回调(回调中可重新提交该请求)
+ * @param       req: 请求
+ * @retval      无
+ */
+static void bbus_i2c_coal_complete(bbus_i2c_coal_req_t *req)
+{
+    req->state = BBUS_I2C_COAL_DONE;
+    if (req->cb)
+    {
+        req->cb(req);
+    }
+}
+
+/**
+ * @brief       初始化读合并队列
+ * @param       q: 读合并队列
+ * @param       window: 合并窗口(ms)
+ * @retval      无
+ */
+void bbus_i2c_coal_init(bbus_i2c_coal_t *q, uint32_t window)
+{
+    q->head = 0;
+    q->tail = 0;
+    q->window = window;
+    q->first_tick = 0;
+    q->requests = 0;
+    q->bus_reads = 0;
+}
+
+/**
+ * @brief       提交读请求
+ * @param       q: 读合并队列
+ * @param       req: 读请求，dev/reg_address/data/len/cb 由调用者填写
+ * @retval      0，提交成功；1，请求正在执行中或等待回调
+ */
+uint8_t bbus_i2c_coal_submit(bbus_i2c_coal_t *q, bbus_i2c_coal_req_t *req)
+{
+    // READY 的请求仍挂在 flush 取下的链表上，重新入队会改写 next 截断尚未回调的请求
+    if (req->state == BBUS_I2C_COAL_PENDING || req->state == BBUS_I2C_COAL_GROUPED || req->state == BBUS_I2C_COAL_READY)
+    {
+        return 1;
+    }
+    req->next = 0;
+    req->state = BBUS_I2C_COAL_PENDING;
+
+    if (q->head == 0)
+    {
+        q->head = req;
+        q->first_tick = bbus_i2c_port_tick_get();
+    }
+    else
+    {
+        q->tail->next = req;
+    }
+    q->tail = req;
+
+    return 0;
+}
+
+/**
+ * @brief       合并窗口到期后执行队列中的请求，由周期任务调用
+ * @param       q: 读合并队列
+ * @param       timeout: 单次传输超时时间ms
+ * @retval      本次执行的请求数
+ */
+uint32_t bbus_i2c_coal_poll(bbus_i2c_coal_t *q, uint32_t timeout)
+{
+    if (q->head == 0 || (bbus_i2c_port_tick_get() - q->first_tick) < q->window)
+    {
+        return 0;
+    }
+    return bbus_i2c_coal_flush(q, timeout);
+}
+
+/**
+ * @brief       立即执行队列中的全部请求
+ * @param       q: 读合并队列
+ * @param       timeout: 单次传输超时时间ms
+ * @retval      本次执行的请求数
+ */
+uint32_t bbus_i2c_coal_flush(bbus_i2c_coal_t *q, uint32_t timeout)
+{
+    uint8_t buf[BBUS_I2C_COAL_MAX_BURST];
+    bbus_i2c_coal_req_t *list, *next;
+    uint32_t lo, hi, count = 0;
+    uint8_t ret;
+
+    // 取下整个队列，回调中重新提交的请求留到下一次
+    list = q->head;
+    if (list == 0)
+    {
+        return 0;
+    }
+    q->head = 0;
+    q->tail = 0;
+
+    for (bbus_i2c_coal_req_t *seed = list; seed; seed = seed->next)
+    {
+        if (seed->state != BBUS_I2C_COAL_PENDING)
+        {
+            continue;
+        }
+        bbus_i2c_coal_group(seed, &lo, &hi);
+        q->bus_reads++;
+        if (hi - lo > BBUS_I2C_COAL_MAX_BURST)
+        {
+            seed->result = bbus_i2c_dev_read(seed->dev, seed->reg_address, seed->data, seed->len, timeout);
+            seed->state = BBUS_I2C_COAL_READY;
+            continue;
+        }
+
+        // 一次连续读覆盖整个区间，再分发给各请求
+        ret = bbus_i2c_dev_read(seed->dev, (uint16_t)lo, buf, (uint8_t)(hi - lo), timeout);
+        for (bbus_i2c_coal_req_t *r = seed; r; r = r->next)
+        {
+            if (r->state != BBUS_I2C_COAL_GROUPED)
+            {
+                continue;
+            }
+            r->state = BBUS_I2C_COAL_READY;
+            r->result = ret;
+            for (uint8_t i = 0; ret == 0 && i < r->len; i++)
+            {
+                r->data[i] = buf[r->reg_address - lo + i];
+            }
+        }
+    }
+
+    // 全部读取完成后再调用回调，回调中可重新提交请求
+    for (bbus_i2c_coal_req_t *r = list; r; r = next)
+    {
+        next = r->next;
+        if (r->state == BBUS_I2C_COAL_READY)
+        {
+            count++;
+            bbus_i2c_coal_complete(r);
+        }
+    }
+    q->requests += count;
+
+    return count;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file    bbus_i2c_coal.h
+ * @version v1.0
+ * @date    2026-10-19
+ * @author  ZeroOneLab
+ * @website https://github.com/ZeroOneLab/BBusI2C.git
+ *
+ * @license MIT License
+ * Copyright (c) 2026 ZeroOneLab
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BBUS_I2C_COAL_H
+#define BBUS_I2C_COAL_H
+
+#include "bbus_i2c_dev.h"
+
+/* 请求状态 */
+#define BBUS_I2C_COAL_IDLE    0 // 未提交或已完成被取回
+#define BBUS_I2C_COAL_PENDING 1 // 已提交，等待合并执行
+#define BBUS_I2C_COAL_GROUPED 2 // 已并入一次连续读(内部使用)
+#define BBUS_I2C_COAL_READY   3 // 已读取，等待调用回调(内部使用)
+#define BBUS_I2C_COAL_DONE    4 // 已执行完成，result 有效
+
+typedef struct bbus_i2c_coal_req bbus_i2c_coal_req_t;
+
+/**
+ * @brief   请求完成回调，在执行合并读的上下文中调用，此时 state 已置为 DONE，可在回调中重新提交该请求；
+ *          同一批中尚未回调的其他请求仍为 READY，此时提交会被拒绝
+ * @param   req: 已完成的请求
+ * @retval  无
+ */
+typedef void (*bbus_i2c_coal_cb_t)(bbus_i2c_coal_req_t *req);
+
+/* 读请求：由调用者分配，提交后到完成前不得修改或释放 */
+struct bbus_i2c_coal_req
+{
+    bbus_i2c_dev_t *dev;      /* 设备描述 */
+    uint16_t reg_address;     /* 第一个寄存器地址 */
+    uint8_t *data;            /* 数据缓冲区 */
+    uint8_t len;              /* 数据长度 */
+    bbus_i2c_coal_cb_t cb;    /* 完成回调，可为NULL */
+    void *user;               /* 用户数据 */
+    uint8_t result;           /* 执行结果，0：成功；1：失败 */
+    volatile uint8_t state;   /* 请求状态 BBUS_I2C_COAL_xxx */
+    bbus_i2c_coal_req_t *next; /* 队列链接(内部使用) */
+};
+
+/* 读合并队列：单上下文使用，见 bbus_i2c_coal_submit */
+typedef struct
+{
+    bbus_i2c_coal_req_t *head; /* 待执行请求(按提交顺序) */
+    bbus_i2c_coal_req_t *tail;
+    uint32_t window;           /* 合并窗口(ms)：第一个请求提交后等待该时间再执行 */
+    uint32_t first_tick;       /* 队列中第一个请求的提交时刻 */
+    uint32_t requests;         /* 已执行的请求数 */
+    uint32_t bus_reads;        /* 实际的总线读次数 */
+} bbus_i2c_coal_t;
+
+/**
+ * @brief       初始化读合并队列
+ * @param       q: 读合并队列
+ * @param       window: 合并窗口(ms)
+ * @retval      无
+ */
+void bbus_i2c_coal_init(bbus_i2c_coal_t *q, uint32_t window);
+
+/**
+ * @brief       提交读请求
+ * @note        队列本身不加锁，提交与 poll/flush 须在同一任务中调用(完成回调中可重新提交)；
+ *              多个任务或中断共享同一队列时，由调用者在外部加锁
+ * @param       q: 读合并队列
+ * @param       req: 读请求，dev/reg_address/data/len/cb 由调用者填写
+ * @retval      0，提交成功；1，请求正在执行中或等待回调
+ */
+uint8_t bbus_i2c_coal_submit(bbus_i2c_coal_t *q, bbus_i2c_coal_req_t *req);
+
+/**
+ * @brief       合并窗口到期后执行队列中的请求，由周期任务调用
+ * @param       q: 读合并队列
+ * @param       timeout: 单次传输超时时间ms
+ * @retval      本次执行的请求数
+ */
+uint32_t bbus_i2c_coal_poll(bbus_i2c_coal_t *q, uint32_t timeout);
+
+/**
+ * @brief       立即执行队列中的全部请求
+ * @note        同一设备上重叠或相邻的请求合并为一次连续读(不超过 BBUS_I2C_COAL_MAX_BURST 字节)，
+ *              读取结果分发到各请求的缓冲区
+ * @param       q: 读合并队列
+ * @param       timeout: 单次传输超时时间ms
+ * @retval      本次执行的请求数
+ */
+uint32_t bbus_i2c_coal_flush(bbus_i2c_coal_t *q, uint32_t timeout);
+
+#endif
@@ -0,0 +1,261 @@
+/**
+ * @file    bbus_i2c_dev.c
+ * @version v1.0
+ * @date    2026-10-19
+ * @author  ZeroOneLab
+ * @website https://github.com/ZeroOneLab/BBusI2C.git
+ *
+ * @license MIT License
+ * Copyright (c) 2026 ZeroOneLab
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "bbus_i2c_dev.h"
+
+/* 传输前保存的总线时序，传输结束后恢复 */
+typedef struct
+{
+    uint32_t delay_time;
+    uint32_t stretch_timeout;
+} bbus_i2c_dev_saved_t;
+
+/**
+ * @brief       获取总线并切换为设备的时序参数
+ * @param       dev: 设备描述
+ * @param       saved: 保存总线原有时序
+ * @param       timeout: 获取总线超时时间ms
+ * @retval      0，成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时
+ */
+static uint8_t bbus_i2c_dev_begin(const bbus_i2c_dev_t *dev, bbus_i2c_dev_saved_t *saved, uint32_t timeout)
+{
+    if (bbus_i2c_lock(dev->lun, timeout))
+    {
+        return BBUS_I2C_ERR_LOCK_TIMEOUT;
+    }
+    saved->delay_time = bbus_i2c_get_delay_time(dev->lun);
+    saved->stretch_timeout = bbus_i2c_get_stretch_timeout(dev->lun);
+    bbus_i2c_set_delay_time(dev->lun, dev->delay_time);
+    bbus_i2c_set_stretch_timeout(dev->lun, dev->stretch_timeout);
+    return 0;
+}
+
+static void bbus_i2c_dev_end(const bbus_i2c_dev_t *dev, const bbus_i2c_dev_saved_t *saved)
+{
+    bbus_i2c_set_delay_time(dev->lun, saved->delay_time);
+    bbus_i2c_set_stretch_timeout(dev->lun, saved->stretch_timeout);
+    bbus_i2c_unlock(dev->lun);
+}
+
+/**
+ * @brief       判断失败后是否还需重试
+ * @param       dev: 设备描述
+ * @param       attempt: 已重试次数
+ * @retval      1，需要重试；0，不再重试
+ */
+static uint8_t bbus_i2c_dev_retry(const bbus_i2c_dev_t *dev, uint8_t attempt)
+{
+    if (attempt >= dev->retries)
+    {
+        return 0;
+    }
+    BBUS_I2C_LOG("[I2C Dev][WARN]: Retry %d for address 0x%02X on bus %d\n", attempt + 1, dev->slave_addr, dev->lun);
+    if (dev->retry_delay)
+    {
+        bbus_i2c_port_delay_us(dev->retry_delay);
+    }
+    return 1;
+}
+
+/**
+ * @brief       传输结束后更新设备的寄存器指针
+ * @param       dev: 设备描述
+ * @param       ret: 传输结果，失败时指针未知
+ * @param       reg_address: 本次传输的起始寄存器地址
+ * @param       len: 本次传输的数据长度
+ * @retval      无
+ */
+static void bbus_i2c_dev_ptr_update(bbus_i2c_dev_t *dev, uint8_t ret, uint16_t reg_address, uint8_t len)
+{
+    if (ret)
+    {
+        dev->ptr_valid = 0;
+        return;
+    }
+    if (dev->reg_width == 0)
+    {
+        reg_address = dev->ptr; // 无寄存器地址阶段：从当前指针继续递增
+    }
+    else
+    {
+        dev->ptr_valid = 1;
+    }
+    dev->ptr = (uint16_t)(reg_address + len);
+    if (dev->reg_width == 1)
+    {
+        dev->ptr &= 0xFF;
+    }
+}
+
+/**
+ * @brief       初始化设备描述
+ * @param       dev: 设备描述
+ * @param       lun: I2C总线号
+ * @param       slave_addr: 从设备地址
+ * @param       reg_width: 寄存器地址宽度(字节)，0：无寄存器地址，1：8位，2：16位(高字节在前)
+ * @param       max_khz: 设备支持的最高通信频率(kHz)，0 表示不限速
+ * @retval      无
+ */
+void bbus_i2c_dev_init(bbus_i2c_dev_t *dev, uint8_t lun, uint16_t slave_addr, uint8_t reg_width, uint32_t max_khz)
+{
+    dev->lun = lun;
+    dev->slave_addr = slave_addr;
+    dev->reg_width = reg_width;
+    dev->retries = 0;
+    dev->stretch_timeout = 0;
+    dev->retry_delay = 0;
+    dev->ptr_track = 0;
+    dev->ptr_valid = 0;
+    dev->ptr = 0;
+    dev->ptr_hits = 0;
+    bbus_i2c_dev_set_speed(dev, max_khz);
+}
+
+/**
+ * @brief       设置设备最高通信频率
+ * @note        半周期延时向上取整，实际频率不超过 max_khz
+ * @param       dev: 设备描述
+ * @param       max_khz: 最高通信频率(kHz)，0 表示不限速
+ * @retval      无
+ */
+void bbus_i2c_dev_set_speed(bbus_i2c_dev_t *dev, uint32_t max_khz)
+{
+    dev->delay_time = (max_khz == 0) ? 0 : (500 + max_khz - 1) / max_khz;
+}
+
+/**
+ * @brief       设置设备的时钟延展最长等待时间
+ * @param       dev: 设备描述
+ * @param       xus: 最长等待时间 (单位: us)，0 表示关闭时钟延展检测
+ * @retval      无
+ */
+void bbus_i2c_dev_set_stretch_timeout(bbus_i2c_dev_t *dev, uint32_t xus)
+{
+    dev->stretch_timeout = xus;
+}
+
+/**
+ * @brief       设置设备的重试策略
+ * @param       dev: 设备描述
+ * @param       retries: 失败后的重试次数
+ * @param       retry_delay: 两次重试之间的间隔 (单位: us)
+ * @retval      无
+ */
+void bbus_i2c_dev_set_retry(bbus_i2c_dev_t *dev, uint8_t retries, uint32_t retry_delay)
+{
+    dev->retries = retries;
+    dev->retry_delay = retry_delay;
+}
+
+/**
+ * @brief       设置寄存器指针跟踪
+ * @param       dev: 设备描述
+ * @param       enable: 1：开启；0：关闭
+ * @retval      无
+ */
+void bbus_i2c_dev_set_ptr_tracking(bbus_i2c_dev_t *dev, uint8_t enable)
+{
+    dev->ptr_track = enable;
+    dev->ptr_valid = 0;
+}
+
+/**
+ * @brief       使已记录的寄存器指针失效，下一次读取使用完整的寄存器地址阶段
+ * @param       dev: 设备描述
+ * @retval      无
+ */
+void bbus_i2c_dev_invalidate_ptr(bbus_i2c_dev_t *dev)
+{
+    dev->ptr_valid = 0;
+}
+
+/**
+ * @brief       按设备写寄存器
+ * @param       dev: 设备描述
+ * @param       reg_address: 寄存器地址(reg_width 为0时忽略)
+ * @param       data: 要写入的数据
+ * @param       len: 要写入的数据长度
+ * @param       timeout: 超时时间ms
+ * @retval      0，写入成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，写入失败(已用完重试次数)
+ */
+uint8_t bbus_i2c_dev_write(bbus_i2c_dev_t *dev, uint16_t reg_address, const uint8_t *data, uint8_t len, uint32_t timeout)
+{
+    bbus_i2c_dev_saved_t saved;
+    uint8_t attempt = 0, ret;
+
+    if (bbus_i2c_dev_begin(dev, &saved, timeout))
+    {
+        return BBUS_I2C_ERR_LOCK_TIMEOUT; // 获取总线失败
+    }
+    do
+    {
+        ret = bbus_i2c_write_reg(dev->lun, dev->slave_addr, reg_address, dev->reg_width, data, len, timeout);
+        bbus_i2c_dev_ptr_update(dev, ret, reg_address, len);
+    } while (ret && bbus_i2c_dev_retry(dev, attempt++));
+    bbus_i2c_dev_end(dev, &saved);
+
+    return ret;
+}
+
+/**
+ * @brief       按设备读寄存器
+ * @param       dev: 设备描述
+ * @param       reg_address: 寄存器地址(reg_width 为0时忽略)
+ * @param       data: 存储读取数据的缓冲区
+ * @param       len: 要读取的数据长度
+ * @param       timeout: 超时时间ms
+ * @retval      0，读取成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，读取失败(已用完重试次数)
+ */
+uint8_t bbus_i2c_dev_read(bbus_i2c_dev_t *dev, uint16_t reg_address, uint8_t *data, uint8_t len, uint32_t timeout)
+{
+    bbus_i2c_dev_saved_t saved;
+    uint8_t attempt = 0, ret;
+
+    if (bbus_i2c_dev_begin(dev, &saved, timeout))
+    {
+        return BBUS_I2C_ERR_LOCK_TIMEOUT; // 获取总线失败
+    }
+    do
+    {
+        if (dev->ptr_track && dev->ptr_valid && dev->ptr == reg_address)
+        {
+            // 设备指针已指向目标寄存器：当前地址读
+            dev->ptr_hits++;
+            ret = bbus_i2c_read_reg(dev->lun, dev->slave_addr, 0, 0, data, len, timeout);
+        }
+        else
+        {
+            ret = bbus_i2c_read_reg(dev->lun, dev->slave_addr, reg_address, dev->reg_width, data, len, timeout);
+        }
+        bbus_i2c_dev_ptr_update(dev, ret, reg_address, len);
+    } while (ret && bbus_i2c_dev_retry(dev, attempt++));
+    bbus_i2c_dev_end(dev, &saved);
+
+    return ret;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file    bbus_i2c_dev.h
+ * @version v1.0
+ * @date    2026-10-19
+ * @author  ZeroOneLab
+ * @website https://github.com/ZeroOneLab/BBusI2C.git
+ *
+ * @license MIT License
+ * Copyright (c) 2026 ZeroOneLab
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BBUS_I2C_DEV_H
+#define BBUS_I2C_DEV_H
+
+#include "bbus_i2c.h"
+
+/* 设备描述：同一总线上的设备各自保存时序参数，按设备句柄访问时自动切换总线时序 */
+typedef struct
+{
+    uint8_t lun;              /* I2C总线号 */
+    uint16_t slave_addr;      /* 从设备地址，10位地址为 BBUS_I2C_ADDR10(addr) */
+    uint8_t reg_width;        /* 寄存器地址宽度(字节)，0~2 */
+    uint8_t retries;          /* 传输失败后的重试次数 */
+    uint32_t delay_time;      /* 半周期延时(us)，由最高通信频率换算 */
+    uint32_t stretch_timeout; /* 时钟延展最长等待时间(us)，0 表示不检测 */
+    uint32_t retry_delay;     /* 两次重试之间的间隔(us) */
+    uint8_t ptr_track;        /* 1：跟踪设备内部寄存器指针 */
+    uint8_t ptr_valid;        /* 寄存器指针已知 */
+    uint16_t ptr;             /* 设备内部寄存器指针(下一次读写的寄存器地址) */
+    uint32_t ptr_hits;        /* 使用当前地址读(省略寄存器地址阶段)的次数 */
+} bbus_i2c_dev_t;
+
+/**
+ * @brief       初始化设备描述
+ * @param       dev: 设备描述
+ * @param       lun: I2C总线号
+ * @param       slave_addr: 从设备地址
+ * @param       reg_width: 寄存器地址宽度(字节)，0：无寄存器地址，1：8位，2：16位(高字节在前)
+ * @param       max_khz: 设备支持的最高通信频率(kHz)，0 表示不限速
+ * @retval      无
+ */
+void bbus_i2c_dev_init(bbus_i2c_dev_t *dev, uint8_t lun, uint16_t slave_addr, uint8_t reg_width, uint32_t max_khz);
+
+/**
+ * @brief       设置设备最高通信频率
+ * @param       dev: 设备描述
+ * @param       max_khz: 最高通信频率(kHz)，0 表示不限速
+ * @retval      无
+ */
+void bbus_i2c_dev_set_speed(bbus_i2c_dev_t *dev, uint32_t max_khz);
+
+/**
+ * @brief       设置设备的时钟延展最长等待时间
+ * @param       dev: 设备描述
+ * @param       xus: 最长等待时间 (单位: us)，0 表示关闭时钟延展检测
+ * @retval      无
+ */
+void bbus_i2c_dev_set_stretch_timeout(bbus_i2c_dev_t *dev, uint32_t xus);
+
+/**
+ * @brief       设置设备的重试策略
+ * @param       dev: 设备描述
+ * @param       retries: 失败后的重试次数
+ * @param       retry_delay: 两次重试之间的间隔 (单位: us)
+ * @retval      无
+ */
+void bbus_i2c_dev_set_retry(bbus_i2c_dev_t *dev, uint8_t retries, uint32_t retry_delay);
+
+/**
+ * @brief       设置寄存器指针跟踪
+ * @note        适用于寄存器指针在读写后自动递增的设备(EEPROM、RTC及多数传感器)。开启后每次传输后记录设备的
+ *              寄存器指针，读取的起始寄存器恰好等于指针时改用当前地址读，省去地址(写)、寄存器地址与重复起始信号。
+ *              指针按寄存器地址宽度线性递增回绕；指针行为不同(如按页回绕)或设备被其他途径访问、复位后，
+ *              应调用 bbus_i2c_dev_invalidate_ptr
+ * @param       dev: 设备描述
+ * @param       enable: 1：开启；0：关闭
+ * @retval      无
+ */
+void bbus_i2c_dev_set_ptr_tracking(bbus_i2c_dev_t *dev, uint8_t enable);
+
+/**
+ * @brief       使已记录的寄存器指针失效，下一次读取使用完整的寄存器地址阶段
+ * @param       dev: 设备描述
+ * @retval      无
+ */
+void bbus_i2c_dev_invalidate_ptr(bbus_i2c_dev_t *dev);
+
+/**
+ * @brief       按设备写寄存器
+ * @note        传输期间持有总线锁并切换为设备的时序参数，结束后恢复总线原有设置
+ * @param       dev: 设备描述
+ * @param       reg_address: 寄存器地址(reg_width 为0时忽略)
+ * @param       data: 要写入的数据
+ * @param       len: 要写入的数据长度
+ * @param       timeout: 超时时间ms
+ * @retval      0，写入成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，写入失败(已用完重试次数)
+ */
+uint8_t bbus_i2c_dev_write(bbus_i2c_dev_t *dev, uint16_t reg_address, const uint8_t *data, uint8_t len, uint32_t timeout);
+
+/**
+ * @brief       按设备读寄存器
+ * @note        reg_width 为0时直接读取字节序列(无寄存器地址阶段)
+ * @param       dev: 设备描述
+ * @param       reg_address: 寄存器地址(reg_width 为0时忽略)
+ * @param       data: 存储读取数据的缓冲区
+ * @param       len: 要读取的数据长度
+ * @param       timeout: 超时时间ms
+ * @retval      0，读取成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，读取失败(已用完重试次数)
+ */
+uint8_t bbus_i2c_dev_read(bbus_i2c_dev_t *dev, uint16_t reg_address, uint8_t *data, uint8_t len, uint32_t timeout);
+
+#endif
@@ -0,0 +1,208 @@
+/**
+ * @file    bbus_i2c_event.c
+ * @version v1.0
+ * @date    2026-10-19
+ * @author  ZeroOneLab
+ * @website https://github.com/ZeroOneLab/BBusI2C.git
+ *
+ * @license MIT License
+ * Copyright (c) 2026 ZeroOneLab
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "bbus_i2c_event.h"
+#include "bbus_i2c_smbus.h"
+
+/**
+ * @brief       初始化事件组
+ * @param       g: 事件组
+ * @param       alert_lun: SMBALERT#所在总线，没有时为 BBUS_I2C_EVENT_NO_ALERT
+ * @retval      无
+ */
+void bbus_i2c_event_group_init(bbus_i2c_event_group_t *g, uint8_t alert_lun)
+{
+    g->head = 0;
+    g->pending = 0;
+    g->alert = 0;
+    g->alert_lun = alert_lun;
+    g->alerts = 0;
+    g->unclaimed = 0;
+}
+
+/**
+ * @brief       初始化事件并绑定到事件组
+ * @param       g: 事件组
+ * @param       ev: 事件
+ * @param       dev: 设备描述
+ * @param       reg_address: 寄存器地址
+ * @param       data: 数据缓冲区
+ * @param       len: 数据长度
+ * @param       cb: 完成回调，可为NULL
+ * @param       user: 用户数据
+ * @retval      无
+ */
+void bbus_i2c_event_attach(bbus_i2c_event_group_t *g, bbus_i2c_event_t *ev, bbus_i2c_dev_t *dev, uint16_t reg_address,
+                           uint8_t *data, uint8_t len, bbus_i2c_event_cb_t cb, void *user)
+{
+    ev->dev = dev;
+    ev->reg_address = reg_address;
+    ev->data = data;
+    ev->len = len;
+    ev->cb = cb;
+    ev->user = user;
+    ev->pending = 0;
+    ev->reads = 0;
+    ev->overruns = 0;
+    ev->next = g->head;
+    g->head = ev;
+}
+
+/**
+ * @brief       DRDY/INT引脚中断到来，在该引脚的外部中断服务函数中调用
+ * @param       g: 事件组
+ * @param       ev: 该引脚对应的事件
+ * @retval      无
+ */
+void bbus_i2c_event_irq(bbus_i2c_event_group_t *g, bbus_i2c_event_t *ev)
+{
+    if (ev->pending)
+    {
+        ev->overruns++;
+    }
+    ev->pending = 1;
+    g->pending = 1;
+}
+
+/**
+ * @brief       SMBALERT#中断到来，在该引脚的外部中断服务函数中调用
+ * @param       g: 事件组
+ * @retval      无
+ */
+void bbus_i2c_event_alert_irq(bbus_i2c_event_group_t *g)
+{
+    g->alert = 1;
+    g->pending = 1;
+}
+
+/**
+ * @brief       查询报警响应地址，获取正在拉低SMBALERT#的设备
+ * @param       lun: I2C总线号
+ * @param       slave_addr: 返回设备地址(8位形式，最低位为0)
+ * @param       timeout: 超时时间ms
+ * @retval      0，有设备响应；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，无设备响应或传输失败(地址未应答时 bbus_i2c_get_error 为 BBUS_I2C_ERR_NACK)
+ * @note        多个设备同时报警时地址最小的设备仲裁获胜，响应后释放SMBALERT#，再次查询得到下一个设备
+ */
+uint8_t bbus_i2c_event_ara(uint8_t lun, uint8_t *slave_addr, uint32_t timeout)
+{
+    uint8_t addr, ret;
+
+    ret = bbus_i2c_smbus_receive_byte(lun, BBUS_I2C_EVENT_ARA, &addr, timeout);
+    if (ret)
+    {
+        return ret;
+    }
+    *slave_addr = addr & 0xFE;
+    return 0;
+}
+
+/**
+ * @brief       通过报警响应地址找出报警的设备，并置位其绑定的事件
+ * @param       g: 事件组
+ * @param       timeout: 单次传输超时时间ms
+ * @retval      无
+ */
+static void bbus_i2c_event_resolve_alert(bbus_i2c_event_group_t *g, uint32_t timeout)
+{
+    uint8_t addr, claimed, ret;
+
+    for (uint8_t i = 0; i < BBUS_I2C_EVENT_ARA_MAX; i++)
+    {
+        ret = bbus_i2c_event_ara(g->alert_lun, &addr, timeout);
+        if (ret)
+        {
+            if (ret == 1 && bbus_i2c_smbus_get_error(g->alert_lun) == BBUS_I2C_SMBUS_ERR_BUS &&
+                bbus_i2c_get_error(g->alert_lun) == BBUS_I2C_ERR_NACK)
+            {
+                return; // 报警响应地址未应答：没有设备再报警
+            }
+            // 总线忙、时钟延展超时、PEC错误等：报警设备未被读出，SMBALERT#仍被拉低，留到下次继续查询
+            BBUS_I2C_LOG("[I2C Event][ERROR]: Alert response query failed on bus %d\n", g->alert_lun);
+            break;
+        }
+        g->alerts++;
+        claimed = 0;
+        for (bbus_i2c_event_t *ev = g->head; ev; ev = ev->next)
+        {
+            if (ev->dev->lun == g->alert_lun && ev->dev->slave_addr == addr)
+            {
+                ev->pending = 1;
+                claimed = 1;
+            }
+        }
+        if (!claimed)
+        {
+            g->unclaimed++;
+            BBUS_I2C_LOG("[I2C Event][ERROR]: Unclaimed alert from address 0x%02X\n", addr);
+        }
+    }
+    // 查询次数用尽或查询失败时SMBALERT#可能仍被拉低，不会再有新的边沿，留到下次继续查询
+    g->alert = 1;
+    g->pending = 1;
+}
+
+/**
+ * @brief       执行已到来的事件，由任务循环调用
+ * @param       g: 事件组
+ * @param       timeout: 单次传输超时时间ms
+ * @retval      本次执行的读取次数
+ * @note        没有中断到来时直接返回，不占用总线
+ */
+uint32_t bbus_i2c_event_poll(bbus_i2c_event_group_t *g, uint32_t timeout)
+{
+    uint32_t count = 0;
+    uint8_t result;
+
+    if (!g->pending)
+    {
+        return 0;
+    }
+    g->pending = 0; // 先清除，处理期间到来的中断在下次调用时执行
+    if (g->alert && g->alert_lun != BBUS_I2C_EVENT_NO_ALERT)
+    {
+        g->alert = 0;
+        bbus_i2c_event_resolve_alert(g, timeout);
+    }
+    for (bbus_i2c_event_t *ev = g->head; ev; ev = ev->next)
+    {
+        if (!ev->pending)
+        {
+            continue;
+        }
+        ev->pending = 0;
+        result = bbus_i2c_dev_read(ev->dev, ev->reg_address, ev->data, ev->len, timeout);
+        ev->reads++;
+        count++;
+        if (ev->cb)
+        {
+            ev->cb(ev, result);
+        }
+    }
+    return count;
+}
@@ -0,0 +1,131 @@
+/**
+ * @file    bbus_i2c_event.h
+ * @version v1.0
+ * @date    2026-10-19
+ * @author  ZeroOneLab
+ * @website https://github.com/ZeroOneLab/BBusI2C.git
+ *
+ * @license MIT License
+ * Copyright (c) 2026 ZeroOneLab
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BBUS_I2C_EVENT_H
+#define BBUS_I2C_EVENT_H
+
+#include "bbus_i2c_dev.h"
+
+#define BBUS_I2C_EVENT_ARA      0x18 // SMBus报警响应地址(Alert Response Address)
+#define BBUS_I2C_EVENT_NO_ALERT 0xFF // 事件组不带SMBALERT#线
+
+typedef struct bbus_i2c_event bbus_i2c_event_t;
+
+/**
+ * @brief   事件读取完成回调，在 bbus_i2c_event_poll 的上下文中调用
+ * @param   ev: 已执行的事件
+ * @param   result: 读取结果，0：成功；1：失败
+ * @retval  无
+ */
+typedef void (*bbus_i2c_event_cb_t)(bbus_i2c_event_t *ev, uint8_t result);
+
+/* 事件：中断到来后执行一次读取，由调用者静态分配 */
+struct bbus_i2c_event
+{
+    bbus_i2c_dev_t *dev;       /* 设备描述 */
+    uint16_t reg_address;      /* 寄存器地址 */
+    uint8_t *data;             /* 数据缓冲区 */
+    uint8_t len;               /* 数据长度 */
+    bbus_i2c_event_cb_t cb;    /* 完成回调，可为NULL */
+    void *user;                /* 用户数据 */
+    volatile uint8_t pending;  /* 中断已到来，等待读取 */
+    uint32_t reads;            /* 已执行的读取次数 */
+    uint32_t overruns;         /* 上一次中断尚未处理时再次到来的次数 */
+    bbus_i2c_event_t *next;    /* 事件组链接(内部使用) */
+};
+
+/* 事件组：一组事件与可选的共享SMBALERT#线 */
+typedef struct
+{
+    bbus_i2c_event_t *head;   /* 已绑定的事件 */
+    volatile uint8_t pending; /* 有中断待处理 */
+    volatile uint8_t alert;   /* SMBALERT#已触发 */
+    uint8_t alert_lun;        /* SMBALERT#所在总线，BBUS_I2C_EVENT_NO_ALERT表示没有 */
+    uint32_t alerts;          /* 报警响应地址查询到的设备数 */
+    uint32_t unclaimed;       /* 查询到但没有绑定事件的设备数 */
+} bbus_i2c_event_group_t;
+
+/**
+ * @brief       初始化事件组
+ * @param       g: 事件组
+ * @param       alert_lun: SMBALERT#所在总线，没有时为 BBUS_I2C_EVENT_NO_ALERT
+ * @retval      无
+ */
+void bbus_i2c_event_group_init(bbus_i2c_event_group_t *g, uint8_t alert_lun);
+
+/**
+ * @brief       初始化事件并绑定到事件组
+ * @param       g: 事件组
+ * @param       ev: 事件
+ * @param       dev: 设备描述
+ * @param       reg_address: 寄存器地址
+ * @param       data: 数据缓冲区
+ * @param       len: 数据长度
+ * @param       cb: 完成回调，可为NULL
+ * @param       user: 用户数据
+ * @retval      无
+ */
+void bbus_i2c_event_attach(bbus_i2c_event_group_t *g, bbus_i2c_event_t *ev, bbus_i2c_dev_t *dev, uint16_t reg_address,
+                           uint8_t *data, uint8_t len, bbus_i2c_event_cb_t cb, void *user);
+
+/**
+ * @brief       DRDY/INT引脚中断到来，在该引脚的外部中断服务函数中调用
+ * @param       g: 事件组
+ * @param       ev: 该引脚对应的事件
+ * @retval      无
+ */
+void bbus_i2c_event_irq(bbus_i2c_event_group_t *g, bbus_i2c_event_t *ev);
+
+/**
+ * @brief       SMBALERT#中断到来，在该引脚的外部中断服务函数中调用
+ * @param       g: 事件组
+ * @retval      无
+ */
+void bbus_i2c_event_alert_irq(bbus_i2c_event_group_t *g);
+
+/**
+ * @brief       查询报警响应地址，获取正在拉低SMBALERT#的设备
+ * @param       lun: I2C总线号
+ * @param       slave_addr: 返回设备地址(8位形式，最低位为0)
+ * @param       timeout: 超时时间ms
+ * @retval      0，有设备响应；1，无设备响应
+ * @note        多个设备同时报警时地址最小的设备仲裁获胜，响应后释放SMBALERT#，再次查询得到下一个设备
+ */
+uint8_t bbus_i2c_event_ara(uint8_t lun, uint8_t *slave_addr, uint32_t timeout);
+
+/**
+ * @brief       执行已到来的事件，由任务循环调用
+ * @param       g: 事件组
+ * @param       timeout: 单次传输超时时间ms
+ * @retval      本次执行的读取次数
+ * @note        没有中断到来时直接返回，不占用总线
+ */
+uint32_t bbus_i2c_event_poll(bbus_i2c_event_group_t *g, uint32_t timeout);
+
+#endif
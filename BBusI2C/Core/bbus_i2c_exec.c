@@ -0,0 +1,340 @@
+/**
+ * @file    bbus_i2c_exec.c
+ * @version v1.0
+ * @date    2026-10-19
+ * @author  ZeroOneLab
+ * @website https://github.com/ZeroOneLab/BBusI2C.git
+ *
+ * @license MIT License
+ * Copyright (c) 2026 ZeroOneLab
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "bbus_i2c_exec.h"
+
+#if BBUS_I2C_USE_EXEC
+
+#if (BBUS_I2C_OS == BBUS_I2C_OS_POSIX)
+#include <pthread.h>
+#endif
+
+#define EXEC_QUEUE_MASK (BBUS_I2C_EXEC_QUEUE_LEN - 1u)
+
+#if (BBUS_I2C_EXEC_QUEUE_LEN & EXEC_QUEUE_MASK) != 0
+#error "BBUS_I2C_EXEC_QUEUE_LEN must be a power of 2"
+#endif
+
+/* 队列槽位：seq 表示槽位的轮次，生产者/消费者据此判断槽位是否可写/可读 */
+typedef struct
+{
+    _Atomic uint32_t seq;
+    bbus_i2c_req_t *req;
+} bbus_i2c_exec_slot_t;
+
+/* 每条总线的有界多生产者单消费者队列。生产者共享的 tail 与工作线程独占的 head
+ * 分别按缓存行对齐，不同总线的队列之间也互不共享缓存行 */
+typedef struct
+{
+    _Atomic uint32_t tail BBUS_I2C_ALIGNED; /* 生产者写入位置 */
+    _Atomic uint32_t rejected;              /* 队列满被拒绝的请求数 */
+    uint32_t head BBUS_I2C_ALIGNED;         /* 工作线程读取位置 */
+    /* 统计由工作线程单独写入、其他线程读取：stats_seq 为奇数表示正在更新，读者据此重读，
+     * 保证 completed 与 busy_cycles 是同一时刻的快照。busy_cycles 按64位累加(纳秒计数的
+     * 32位值约4秒回绕)，但拆成两个32位原子量，避免32位MCU上缺少64位原子操作 */
+    _Atomic uint32_t stats_seq;
+    _Atomic uint32_t completed;
+    _Atomic uint32_t busy_lo;
+    _Atomic uint32_t busy_hi;
+    bbus_i2c_exec_slot_t slot[BBUS_I2C_EXEC_QUEUE_LEN];
+} BBUS_I2C_ALIGNED bbus_i2c_exec_queue_t;
+
+static bbus_i2c_exec_queue_t exec_queue[BBUS_I2C_BUS_NUM];
+static _Atomic uint8_t exec_running;
+
+#if (BBUS_I2C_OS == BBUS_I2C_OS_POSIX)
+static pthread_t exec_thread[BBUS_I2C_BUS_NUM];
+#endif
+
+/**
+ * @brief   初始化执行器队列，需在 bbus_i2c_init 之后、工作线程启动之前调用
+ * @param   无
+ * @retval  无
+ */
+void bbus_i2c_exec_init(void)
+{
+    for (uint8_t i = 0; i < BBUS_I2C_BUS_NUM; i++)
+    {
+        bbus_i2c_exec_queue_t *q = &exec_queue[i];
+
+        atomic_init(&q->tail, 0);
+        atomic_init(&q->rejected, 0);
+        q->head = 0;
+        atomic_init(&q->stats_seq, 0);
+        atomic_init(&q->completed, 0);
+        atomic_init(&q->busy_lo, 0);
+        atomic_init(&q->busy_hi, 0);
+        for (uint32_t j = 0; j < BBUS_I2C_EXEC_QUEUE_LEN; j++)
+        {
+            atomic_init(&q->slot[j].seq, j);
+            q->slot[j].req = 0;
+        }
+    }
+    atomic_store(&exec_running, 1);
+}
+
+/**
+ * @brief   提交传输请求到对应总线的队列（无锁，可在任意线程中调用）
+ * @param   req: 传输请求，req->lun 指定总线
+ * @retval  0，提交成功；1，队列已满
+ */
+uint8_t bbus_i2c_exec_submit(bbus_i2c_req_t *req)
+{
+    bbus_i2c_exec_queue_t *q = &exec_queue[req->lun];
+    bbus_i2c_exec_slot_t *slot;
+    uint32_t pos = atomic_load_explicit(&q->tail, memory_order_relaxed);
+
+    for (;;)
+    {
+        slot = &q->slot[pos & EXEC_QUEUE_MASK];
+        int32_t diff = (int32_t)(atomic_load_explicit(&slot->seq, memory_order_acquire) - pos);
+
+        if (diff == 0)
+        {
+            /* 槽位空闲，抢占写入位置 */
+            if (atomic_compare_exchange_weak_explicit(&q->tail, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            atomic_fetch_add_explicit(&q->rejected, 1, memory_order_relaxed);
+            return 1; // 队列已满
+        }
+        else
+        {
+            pos = atomic_load_explicit(&q->tail, memory_order_relaxed);
+        }
+    }
+
+    atomic_store_explicit(&req->state, BBUS_I2C_EXEC_PENDING, memory_order_relaxed);
+    slot->req = req;
+    atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+    return 0;
+}
+
+static uint8_t bbus_i2c_exec_do(bbus_i2c_req_t *req)
+{
+    switch (req->op)
+    {
+    case BBUS_I2C_EXEC_OP_CHECK:
+        return bbus_i2c_check_address(req->lun, req->slave_addr, req->timeout);
+    case BBUS_I2C_EXEC_OP_WRITE:
+        return bbus_i2c_write_data(req->lun, req->slave_addr, req->reg_address, req->data, req->len, req->timeout);
+    case BBUS_I2C_EXEC_OP_READ:
+        return bbus_i2c_read_data(req->lun, req->slave_addr, req->reg_address, req->data, req->len, req->timeout);
+    case BBUS_I2C_EXEC_OP_READ_SEQ:
+        return bbus_i2c_read_seq(req->lun, req->slave_addr, req->data, req->len, req->timeout);
+    default:
+        return 1;
+    }
+}
+
+/**
+ * @brief   执行队列中已提交的请求，每条总线只能由一个线程调用
+ * @param   lun: I2C总线号
+ * @param   max: 本次最多执行的请求数
+ * @retval  实际执行的请求数
+ */
+uint32_t bbus_i2c_exec_poll(uint8_t lun, uint32_t max)
+{
+    bbus_i2c_exec_queue_t *q = &exec_queue[lun];
+    uint32_t n = 0;
+
+    while (n < max)
+    {
+        bbus_i2c_exec_slot_t *slot = &q->slot[q->head & EXEC_QUEUE_MASK];
+        bbus_i2c_req_t *req;
+        uint32_t start, cycles, seq, lo;
+
+        if (atomic_load_explicit(&slot->seq, memory_order_acquire) != q->head + 1)
+        {
+            break; // 队列为空
+        }
+        req = slot->req;
+        /* 先归还槽位，执行期间生产者即可继续提交 */
+        atomic_store_explicit(&slot->seq, q->head + BBUS_I2C_EXEC_QUEUE_LEN, memory_order_release);
+        q->head++;
+
+        start = bbus_i2c_port_cycle_get();
+        req->result = bbus_i2c_exec_do(req);
+        cycles = bbus_i2c_port_cycle_get() - start;
+
+        seq = atomic_load_explicit(&q->stats_seq, memory_order_relaxed);
+        atomic_store_explicit(&q->stats_seq, seq + 1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release);
+        lo = atomic_load_explicit(&q->busy_lo, memory_order_relaxed);
+        atomic_store_explicit(&q->busy_lo, lo + cycles, memory_order_relaxed);
+        if (lo + cycles < lo)
+        {
+            atomic_store_explicit(&q->busy_hi, atomic_load_explicit(&q->busy_hi, memory_order_relaxed) + 1, memory_order_relaxed);
+        }
+        atomic_store_explicit(&q->completed, atomic_load_explicit(&q->completed, memory_order_relaxed) + 1, memory_order_relaxed);
+        atomic_store_explicit(&q->stats_seq, seq + 2, memory_order_release);
+        n++;
+
+        /* 回调先于完成标志执行：置为 DONE 后请求归还调用者，不能再访问 */
+        if (req->cb)
+        {
+            req->cb(req);
+        }
+        atomic_store_explicit(&req->state, BBUS_I2C_EXEC_DONE, memory_order_release);
+    }
+    return n;
+}
+
+/**
+ * @brief   总线工作线程主循环，直到 bbus_i2c_exec_stop 被调用后返回
+ * @param   lun: I2C总线号
+ * @retval  无
+ */
+void bbus_i2c_exec_worker(uint8_t lun)
+{
+    while (atomic_load_explicit(&exec_running, memory_order_relaxed))
+    {
+        if (bbus_i2c_exec_poll(lun, BBUS_I2C_EXEC_QUEUE_LEN) == 0)
+        {
+            bbus_i2c_port_delay_us(BBUS_I2C_EXEC_IDLE_US);
+        }
+    }
+    /* 退出前执行完已提交的请求 */
+    while (bbus_i2c_exec_poll(lun, BBUS_I2C_EXEC_QUEUE_LEN) != 0)
+    {
+    }
+}
+
+/**
+ * @brief   通知所有工作线程退出主循环
+ * @param   无
+ * @retval  无
+ */
+void bbus_i2c_exec_stop(void)
+{
+    atomic_store(&exec_running, 0);
+}
+
+/**
+ * @brief   等待请求完成
+ * @param   req: 已提交的传输请求
+ * @param   timeout: 超时时间ms，BBUS_I2C_WAIT_FOREVER 表示永久等待
+ * @retval  请求执行结果；等待超时返回1
+ */
+uint8_t bbus_i2c_exec_wait(bbus_i2c_req_t *req, uint32_t timeout)
+{
+    uint32_t wait_time = bbus_i2c_port_tick_get();
+
+    while (atomic_load_explicit(&req->state, memory_order_acquire) != BBUS_I2C_EXEC_DONE)
+    {
+        if (timeout != BBUS_I2C_WAIT_FOREVER && (bbus_i2c_port_tick_get() - wait_time) >= timeout)
+        {
+            return 1;
+        }
+        bbus_i2c_port_delay_us(BBUS_I2C_EXEC_IDLE_US);
+    }
+    return req->result;
+}
+
+/**
+ * @brief   获取执行器统计（可在任意线程中调用，与工作线程并发时得到一致的快照）
+ * @param   lun: I2C总线号
+ * @param   stats: 输出的统计数据
+ * @retval  无
+ */
+void bbus_i2c_exec_get_stats(uint8_t lun, bbus_i2c_exec_stats_t *stats)
+{
+    bbus_i2c_exec_queue_t *q = &exec_queue[lun];
+    uint32_t seq;
+
+    for (;;)
+    {
+        seq = atomic_load_explicit(&q->stats_seq, memory_order_acquire);
+        if (seq & 1u)
+        {
+            continue; // 工作线程正在更新
+        }
+        stats->completed = atomic_load_explicit(&q->completed, memory_order_relaxed);
+        stats->busy_cycles = ((uint64_t)atomic_load_explicit(&q->busy_hi, memory_order_relaxed) << 32) |
+                             atomic_load_explicit(&q->busy_lo, memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&q->stats_seq, memory_order_relaxed) == seq)
+        {
+            break;
+        }
+    }
+    stats->rejected = atomic_load_explicit(&q->rejected, memory_order_relaxed);
+}
+
+#if (BBUS_I2C_OS == BBUS_I2C_OS_POSIX)
+static void *bbus_i2c_exec_thread(void *arg)
+{
+    bbus_i2c_exec_worker((uint8_t)(uintptr_t)arg);
+    return 0;
+}
+
+/**
+ * @brief   为每条总线创建一个 POSIX 工作线程
+ * @param   无
+ * @retval  0，成功；1，创建线程失败
+ */
+uint8_t bbus_i2c_exec_start(void)
+{
+    atomic_store(&exec_running, 1);
+    for (uint8_t i = 0; i < BBUS_I2C_BUS_NUM; i++)
+    {
+        if (pthread_create(&exec_thread[i], 0, bbus_i2c_exec_thread, (void *)(uintptr_t)i) != 0)
+        {
+            BBUS_I2C_LOG("[I2C Exec][ERROR]: Create worker for bus %d failed\n", i);
+            bbus_i2c_exec_stop();
+            while (i-- > 0)
+            {
+                pthread_join(exec_thread[i], 0);
+            }
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief   停止并回收所有 POSIX 工作线程
+ * @param   无
+ * @retval  无
+ */
+void bbus_i2c_exec_join(void)
+{
+    bbus_i2c_exec_stop();
+    for (uint8_t i = 0; i < BBUS_I2C_BUS_NUM; i++)
+    {
+        pthread_join(exec_thread[i], 0);
+    }
+}
+#endif
+
+#endif
@@ -0,0 +1,154 @@
+/**
+ * @file    bbus_i2c_exec.h
+ * @version v1.0
+ * @date    2026-10-19
+ * @author  ZeroOneLab
+ * @website https://github.com/ZeroOneLab/BBusI2C.git
+ *
+ * @license MIT License
+ * Copyright (c) 2026 ZeroOneLab
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BBUS_I2C_EXEC_H
+#define BBUS_I2C_EXEC_H
+
+#include "bbus_i2c.h"
+
+#if BBUS_I2C_USE_EXEC
+
+#include <stdatomic.h>
+
+/* 请求类型 */
+#define BBUS_I2C_EXEC_OP_CHECK    0 // bbus_i2c_check_address
+#define BBUS_I2C_EXEC_OP_WRITE    1 // bbus_i2c_write_data
+#define BBUS_I2C_EXEC_OP_READ     2 // bbus_i2c_read_data
+#define BBUS_I2C_EXEC_OP_READ_SEQ 3 // bbus_i2c_read_seq
+
+/* 请求状态 */
+#define BBUS_I2C_EXEC_IDLE    0 // 未提交或已被取回
+#define BBUS_I2C_EXEC_PENDING 1 // 已提交，等待执行
+#define BBUS_I2C_EXEC_DONE    2 // 已执行完成，result 有效
+
+typedef struct bbus_i2c_req bbus_i2c_req_t;
+
+/**
+ * @brief   请求完成回调，在执行该请求的总线工作线程中调用，此时 state 尚未置为 DONE
+ * @param   req: 已完成的请求
+ * @retval  无
+ */
+typedef void (*bbus_i2c_req_cb_t)(bbus_i2c_req_t *req);
+
+/* 传输请求：由调用者分配，提交后到完成前不得修改或释放 */
+struct bbus_i2c_req
+{
+    uint8_t op;          /* 请求类型 BBUS_I2C_EXEC_OP_xxx */
+    uint8_t lun;         /* I2C总线号 */
+    uint16_t slave_addr; /* 从设备地址 */
+    uint8_t reg_address; /* 寄存器地址 */
+    uint8_t *data;       /* 数据缓冲区 */
+    uint8_t len;         /* 数据长度 */
+    uint32_t timeout;    /* 超时时间ms */
+    bbus_i2c_req_cb_t cb; /* 完成回调，可为NULL */
+    void *user;          /* 用户数据 */
+    uint8_t result;      /* 执行结果，0：成功；1：失败 */
+    _Atomic uint8_t state; /* 请求状态 BBUS_I2C_EXEC_xxx，作为 future 轮询 */
+};
+
+/* 执行器统计 */
+typedef struct
+{
+    uint32_t completed;   /* 已完成的请求数 */
+    uint32_t rejected;    /* 队列满被拒绝的请求数 */
+    uint64_t busy_cycles; /* 执行请求累计耗时，单位为 bbus_i2c_port_cycle_get 的计数 */
+} bbus_i2c_exec_stats_t;
+
+/**
+ * @brief   初始化执行器队列，需在 bbus_i2c_init 之后、工作线程启动之前调用
+ * @param   无
+ * @retval  无
+ */
+void bbus_i2c_exec_init(void);
+
+/**
+ * @brief   提交传输请求到对应总线的队列（无锁，可在任意线程中调用）
+ * @param   req: 传输请求，req->lun 指定总线
+ * @retval  0，提交成功；1，队列已满
+ */
+uint8_t bbus_i2c_exec_submit(bbus_i2c_req_t *req);
+
+/**
+ * @brief   执行队列中已提交的请求，每条总线只能由一个线程调用
+ * @param   lun: I2C总线号
+ * @param   max: 本次最多执行的请求数
+ * @retval  实际执行的请求数
+ */
+uint32_t bbus_i2c_exec_poll(uint8_t lun, uint32_t max);
+
+/**
+ * @brief   总线工作线程主循环，直到 bbus_i2c_exec_stop 被调用后返回
+ * @note    每条总线启动一个工作线程(任务)调用本函数，队列为空时休眠 BBUS_I2C_EXEC_IDLE_US
+ * @param   lun: I2C总线号
+ * @retval  无
+ */
+void bbus_i2c_exec_worker(uint8_t lun);
+
+/**
+ * @brief   通知所有工作线程退出主循环
+ * @param   无
+ * @retval  无
+ */
+void bbus_i2c_exec_stop(void);
+
+/**
+ * @brief   等待请求完成
+ * @param   req: 已提交的传输请求
+ * @param   timeout: 超时时间ms，BBUS_I2C_WAIT_FOREVER 表示永久等待
+ * @retval  请求执行结果；等待超时返回1
+ */
+uint8_t bbus_i2c_exec_wait(bbus_i2c_req_t *req, uint32_t timeout);
+
+/**
+ * @brief   获取执行器统计（可在任意线程中调用，与工作线程并发时得到一致的快照）
+ * @param   lun: I2C总线号
+ * @param   stats: 输出的统计数据
+ * @retval  无
+ */
+void bbus_i2c_exec_get_stats(uint8_t lun, bbus_i2c_exec_stats_t *stats);
+
+#if (BBUS_I2C_OS == BBUS_I2C_OS_POSIX)
+/**
+ * @brief   为每条总线创建一个 POSIX 工作线程
+ * @param   无
+ * @retval  0，成功；1，创建线程失败
+ */
+uint8_t bbus_i2c_exec_start(void);
+
+/**
+ * @brief   停止并回收所有 POSIX 工作线程
+ * @param   无
+ * @retval  无
+ */
+void bbus_i2c_exec_join(void);
+#endif
+
+#endif
+
+#endif
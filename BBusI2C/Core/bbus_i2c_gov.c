@@ -0,0 +1,256 @@
+/**
+ * @file    bbus_i2c_gov.c
+ * @version v1.0
+ * @date    2026-10-19
+ * @author  ZeroOneLab
+ * @website https://github.com/ZeroOneLab/BBusI2C.git
+ *
+ * @license MIT License
+ * Copyright (c) 2026 ZeroOneLab
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "bbus_i2c_gov.h"
+
+#define GOV_PENALTY_MAX 64 /* 提速门限的最大倍数 */
+#define GOV_VERIFY_CHUNK 16 /* 回读校验每次读取的字节数 */
+
+/**
+ * @brief       修改设备速率并记录
+ * @param       gov: 调节器
+ * @param       delay_time: 新的半周期延时(us)
+ * @param       reason: 调速原因
+ * @retval      无
+ */
+static void bbus_i2c_gov_apply(bbus_i2c_gov_t *gov, uint32_t delay_time, uint8_t reason)
+{
+    bbus_i2c_gov_event_t *event = &gov->history[gov->history_head];
+
+    gov->dev->delay_time = delay_time;
+    event->tick = bbus_i2c_port_tick_get();
+    event->delay_time = delay_time;
+    event->reason = reason;
+    gov->history_head = (uint8_t)((gov->history_head + 1) % BBUS_I2C_GOV_HISTORY_LEN);
+    if (gov->history_num < BBUS_I2C_GOV_HISTORY_LEN)
+    {
+        gov->history_num++;
+    }
+}
+
+/**
+ * @brief       初始化速率调节器，设备从最慢速率开始运行
+ * @param       gov: 调节器
+ * @param       dev: 被调节的设备
+ * @param       min_delay: 最快的半周期延时(us)
+ * @param       max_delay: 最慢的半周期延时(us)
+ * @param       up_after: 提速前需要的连续成功次数
+ * @retval      无
+ */
+void bbus_i2c_gov_init(bbus_i2c_gov_t *gov, bbus_i2c_dev_t *dev, uint32_t min_delay, uint32_t max_delay, uint16_t up_after)
+{
+    gov->dev = dev;
+    gov->min_delay = min_delay;
+    gov->max_delay = max_delay;
+    gov->up_after = up_after ? up_after : 1;
+    gov->penalty = 1;
+    gov->clean = 0;
+    gov->ok = 0;
+    gov->nack = 0;
+    gov->mismatch = 0;
+    gov->history_head = 0;
+    gov->history_num = 0;
+    bbus_i2c_gov_apply(gov, max_delay, BBUS_I2C_GOV_OK);
+}
+
+/**
+ * @brief       上报一次传输结果，按结果调节设备速率
+ * @param       gov: 调节器
+ * @param       result: BBUS_I2C_GOV_xxx
+ * @retval      无
+ */
+void bbus_i2c_gov_report(bbus_i2c_gov_t *gov, uint8_t result)
+{
+    uint32_t delay_time = gov->dev->delay_time;
+
+    if (result == BBUS_I2C_GOV_OK)
+    {
+        gov->ok++;
+        if (++gov->clean < (uint32_t)gov->up_after * gov->penalty || delay_time <= gov->min_delay)
+        {
+            return;
+        }
+        // 连续成功：提速一档，并逐步放宽提速门限
+        gov->clean = 0;
+        if (gov->penalty > 1)
+        {
+            gov->penalty >>= 1;
+        }
+        bbus_i2c_gov_apply(gov, delay_time - 1, BBUS_I2C_GOV_OK);
+        return;
+    }
+
+    if (result == BBUS_I2C_GOV_MISMATCH)
+    {
+        gov->mismatch++;
+    }
+    else
+    {
+        gov->nack++;
+    }
+    // 出错：立即降速(延时加倍)，并加倍提速门限
+    gov->clean = 0;
+    if (gov->penalty < GOV_PENALTY_MAX)
+    {
+        gov->penalty <<= 1;
+    }
+    delay_time = delay_time ? delay_time * 2 : 1;
+    if (delay_time > gov->max_delay)
+    {
+        delay_time = gov->max_delay;
+    }
+    if (delay_time != gov->dev->delay_time)
+    {
+        BBUS_I2C_LOG("[I2C Gov][WARN]: Address 0x%02X slow down to %lu us\n", gov->dev->slave_addr, (unsigned long)delay_time);
+        bbus_i2c_gov_apply(gov, delay_time, result);
+    }
+}
+
+/**
+ * @brief       传输失败时判断是否计入错误：获取总线超时与链路质量无关，不上报
+ * @param       gov: 调节器
+ * @param       ret: 传输函数的返回值
+ * @retval      无
+ */
+static void bbus_i2c_gov_report_error(bbus_i2c_gov_t *gov, uint8_t ret)
+{
+    if (ret != BBUS_I2C_ERR_LOCK_TIMEOUT)
+    {
+        bbus_i2c_gov_report(gov, BBUS_I2C_GOV_NACK);
+    }
+}
+
+/**
+ * @brief       读寄存器并自动上报结果
+ * @param       gov: 调节器
+ * @param       reg_address: 寄存器地址
+ * @param       data: 存储读取数据的缓冲区
+ * @param       len: 要读取的数据长度
+ * @param       timeout: 超时时间ms
+ * @retval      0，读取成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，读取失败
+ */
+uint8_t bbus_i2c_gov_read(bbus_i2c_gov_t *gov, uint16_t reg_address, uint8_t *data, uint8_t len, uint32_t timeout)
+{
+    uint8_t retries = gov->dev->retries;
+    uint8_t ret;
+
+    // 调速期间关闭重试，否则被重试恢复的错误不会上报，调节器看不到链路变差
+    gov->dev->retries = 0;
+    ret = bbus_i2c_dev_read(gov->dev, reg_address, data, len, timeout);
+    gov->dev->retries = retries;
+    if (ret)
+    {
+        bbus_i2c_gov_report_error(gov, ret);
+        return ret;
+    }
+    bbus_i2c_gov_report(gov, BBUS_I2C_GOV_OK);
+    return 0;
+}
+
+/**
+ * @brief       写寄存器并回读校验(调用者负责关闭重试)
+ * @param       gov: 调节器
+ * @param       reg_address: 寄存器地址
+ * @param       data: 要写入的数据
+ * @param       len: 要写入的数据长度
+ * @param       timeout: 超时时间ms
+ * @retval      0，写入且校验成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，写入失败或回读不一致
+ */
+static uint8_t bbus_i2c_gov_write_verify_once(bbus_i2c_gov_t *gov, uint16_t reg_address, const uint8_t *data, uint8_t len, uint32_t timeout)
+{
+    uint8_t buf[GOV_VERIFY_CHUNK];
+    uint8_t ret = bbus_i2c_dev_write(gov->dev, reg_address, data, len, timeout);
+
+    if (ret)
+    {
+        bbus_i2c_gov_report_error(gov, ret);
+        return ret;
+    }
+    for (uint16_t i = 0; i < len; i += GOV_VERIFY_CHUNK) // uint16_t：len接近255时uint8_t会回绕
+    {
+        uint8_t n = (uint8_t)((len - i) < GOV_VERIFY_CHUNK ? (len - i) : GOV_VERIFY_CHUNK);
+
+        ret = bbus_i2c_dev_read(gov->dev, (uint16_t)(reg_address + i), buf, n, timeout);
+        if (ret)
+        {
+            bbus_i2c_gov_report_error(gov, ret);
+            return ret;
+        }
+        for (uint8_t j = 0; j < n; j++)
+        {
+            if (buf[j] != data[i + j])
+            {
+                BBUS_I2C_LOG("[I2C Gov][ERROR]: Readback mismatch at register 0x%04X\n", reg_address + i + j);
+                bbus_i2c_gov_report(gov, BBUS_I2C_GOV_MISMATCH);
+                return 1;
+            }
+        }
+    }
+    bbus_i2c_gov_report(gov, BBUS_I2C_GOV_OK);
+    return 0;
+}
+
+/**
+ * @brief       写寄存器并回读校验，自动上报结果
+ * @param       gov: 调节器
+ * @param       reg_address: 寄存器地址
+ * @param       data: 要写入的数据
+ * @param       len: 要写入的数据长度
+ * @param       timeout: 超时时间ms
+ * @retval      0，写入且校验成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，写入失败或回读不一致
+ */
+uint8_t bbus_i2c_gov_write_verify(bbus_i2c_gov_t *gov, uint16_t reg_address, const uint8_t *data, uint8_t len, uint32_t timeout)
+{
+    uint8_t retries = gov->dev->retries;
+    uint8_t ret;
+
+    gov->dev->retries = 0;
+    ret = bbus_i2c_gov_write_verify_once(gov, reg_address, data, len, timeout);
+    gov->dev->retries = retries;
+    return ret;
+}
+
+/**
+ * @brief       按时间顺序(旧到新)读取调速记录
+ * @param       gov: 调节器
+ * @param       events: 记录缓冲区
+ * @param       max: 缓冲区可容纳的记录条数
+ * @retval      实际读取的记录条数
+ */
+uint8_t bbus_i2c_gov_get_history(const bbus_i2c_gov_t *gov, bbus_i2c_gov_event_t *events, uint8_t max)
+{
+    uint8_t n = gov->history_num < max ? gov->history_num : max;
+    uint8_t first = (uint8_t)((gov->history_head + BBUS_I2C_GOV_HISTORY_LEN - n) % BBUS_I2C_GOV_HISTORY_LEN);
+
+    for (uint8_t i = 0; i < n; i++)
+    {
+        events[i] = gov->history[(first + i) % BBUS_I2C_GOV_HISTORY_LEN];
+    }
+    return n;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file    bbus_i2c_gov.h
+ * @version v1.0
+ * @date    2026-10-19
+ * @author  ZeroOneLab
+ * @website https://github.com/ZeroOneLab/BBusI2C.git
+ *
+ * @license MIT License
+ * Copyright (c) 2026 ZeroOneLab
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BBUS_I2C_GOV_H
+#define BBUS_I2C_GOV_H
+
+#include "bbus_i2c_dev.h"
+
+/* 传输结果，由 bbus_i2c_gov_report 上报 */
+#define BBUS_I2C_GOV_OK       0 // 传输成功
+#define BBUS_I2C_GOV_NACK     1 // 未应答/时钟延展超时
+#define BBUS_I2C_GOV_MISMATCH 2 // 写入后回读不一致
+
+/* 一次调速记录 */
+typedef struct
+{
+    uint32_t tick;       /* 调速时刻(ms) */
+    uint32_t delay_time; /* 调速后的半周期延时(us) */
+    uint8_t reason;      /* 调速原因：BBUS_I2C_GOV_OK 为提速，其余为触发降速的错误类型 */
+} bbus_i2c_gov_event_t;
+
+/* 速率调节器：连续成功 up_after 次后提速一档(延时减1us)，出错时立即降速(延时加倍)，
+ * 每次出错后提速所需的连续成功次数加倍，避免在临界速率附近来回振荡 */
+typedef struct
+{
+    bbus_i2c_dev_t *dev;  /* 被调节的设备，直接修改其 delay_time */
+    uint32_t min_delay;   /* 最快的半周期延时(us) */
+    uint32_t max_delay;   /* 最慢的半周期延时(us)，即保守的初始速率 */
+    uint16_t up_after;    /* 提速前需要的连续成功次数 */
+    uint16_t penalty;     /* 提速门限倍数，出错时加倍，提速成功后减半 */
+    uint32_t clean;       /* 当前连续成功次数 */
+    uint32_t ok;          /* 成功次数 */
+    uint32_t nack;        /* 未应答/时钟延展超时次数 */
+    uint32_t mismatch;    /* 回读不一致次数 */
+    bbus_i2c_gov_event_t history[BBUS_I2C_GOV_HISTORY_LEN]; /* 最近的调速记录(环形) */
+    uint8_t history_head; /* 下一条记录的写入位置 */
+    uint8_t history_num;  /* 有效记录条数 */
+} bbus_i2c_gov_t;
+
+/**
+ * @brief       初始化速率调节器，设备从最慢速率开始运行
+ * @param       gov: 调节器
+ * @param       dev: 被调节的设备
+ * @param       min_delay: 最快的半周期延时(us)
+ * @param       max_delay: 最慢的半周期延时(us)
+ * @param       up_after: 提速前需要的连续成功次数
+ * @retval      无
+ */
+void bbus_i2c_gov_init(bbus_i2c_gov_t *gov, bbus_i2c_dev_t *dev, uint32_t min_delay, uint32_t max_delay, uint16_t up_after);
+
+/**
+ * @brief       上报一次传输结果，按结果调节设备速率
+ * @param       gov: 调节器
+ * @param       result: BBUS_I2C_GOV_xxx
+ * @retval      无
+ */
+void bbus_i2c_gov_report(bbus_i2c_gov_t *gov, uint8_t result);
+
+/**
+ * @brief       读寄存器并自动上报结果
+ * @note        传输期间临时关闭设备的重试，每次失败都会上报给调节器
+ * @param       gov: 调节器
+ * @param       reg_address: 寄存器地址
+ * @param       data: 存储读取数据的缓冲区
+ * @param       len: 要读取的数据长度
+ * @param       timeout: 超时时间ms
+ * @retval      0，读取成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，读取失败
+ */
+uint8_t bbus_i2c_gov_read(bbus_i2c_gov_t *gov, uint16_t reg_address, uint8_t *data, uint8_t len, uint32_t timeout);
+
+/**
+ * @brief       写寄存器并回读校验，自动上报结果
+ * @note        仅适用于可回读且写入值不会被设备改变的寄存器；传输期间临时关闭设备的重试
+ * @param       gov: 调节器
+ * @param       reg_address: 寄存器地址
+ * @param       data: 要写入的数据
+ * @param       len: 要写入的数据长度
+ * @param       timeout: 超时时间ms
+ * @retval      0，写入且校验成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，写入失败或回读不一致
+ */
+uint8_t bbus_i2c_gov_write_verify(bbus_i2c_gov_t *gov, uint16_t reg_address, const uint8_t *data, uint8_t len, uint32_t timeout);
+
+/**
+ * @brief       按时间顺序(旧到新)读取调速记录
+ * @param       gov: 调节器
+ * @param       events: 记录缓冲区
+ * @param       max: 缓冲区可容纳的记录条数
+ * @retval      实际读取的记录条数
+ */
+uint8_t bbus_i2c_gov_get_history(const bbus_i2c_gov_t *gov, bbus_i2c_gov_event_t *events, uint8_t max);
+
+#endif
@@ -0,0 +1,335 @@
+/**
+ * @file    bbus_i2c_multi.c
+ * @version v1.0
+ * @date    2026-10-19
+ * @author  ZeroOneLab
+ * @website https://github.com/ZeroOneLab/BBusI2C.git
+ *
+ * @license MIT License
+ * Copyright (c) 2026 ZeroOneLab
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "bbus_i2c_multi.h"
+
+#define SEQ_START 0x100u /* 头部序列标记：发送该字节前先产生(重复)起始信号 */
+
+/* 每条总线的时序状态：每个状态执行一次引脚动作，动作后等待半周期(截止时间) */
+#define M_START_A 0 /* SDA=1, SCL=1 */
+#define M_START_B 1 /* SCL为高时拉低SDA：起始信号 */
+#define M_BIT_A   2 /* 结束上一个时钟(采样后SCL=0)，设置本时钟的SDA */
+#define M_BIT_B   3 /* SCL=1 */
+#define M_NEXT    4 /* 第9个时钟高电平结束：采样应答/保存数据，选择下一个符号 */
+#define M_RSTART  5 /* 重复起始信号：SCL=0, SDA=1 */
+#define M_STOP_A  6 /* SCL=0, SDA=0 */
+#define M_STOP_B  7 /* SCL=1 */
+#define M_STOP_C  8 /* SCL为高时释放SDA：停止信号 */
+#define M_DONE    9
+
+static inline uint8_t multi_sym_is_tx(const bbus_i2c_multi_xfer_t *x)
+{
+    return (x->sym < x->hdr_n) || (x->op == BBUS_I2C_MULTI_WRITE);
+}
+
+static inline uint8_t multi_sym_byte(const bbus_i2c_multi_xfer_t *x)
+{
+    return (x->sym < x->hdr_n) ? (uint8_t)x->hdr[x->sym] : x->data[x->sym - x->hdr_n];
+}
+
+static void multi_prepare(bbus_i2c_multi_xfer_t *x)
+{
+    uint16_t addr = x->slave_addr;
+    uint8_t hi = 0xF0 | ((addr >> 7) & 0x06); // 10位地址首字节 11110xx0
+    uint8_t n = 0;
+
+    // 写地址阶段：读序列在7位地址下省略，10位地址需先写地址再以重复起始信号切换为读
+    if (x->op != BBUS_I2C_MULTI_READ_SEQ || (addr & BBUS_I2C_ADDR_10BIT))
+    {
+        if (addr & BBUS_I2C_ADDR_10BIT)
+        {
+            x->hdr[n++] = SEQ_START | hi;
+            x->hdr[n++] = addr & 0xFF;
+        }
+        else
+        {
+            x->hdr[n++] = SEQ_START | (addr & 0xFE);
+        }
+        if (x->op != BBUS_I2C_MULTI_READ_SEQ)
+        {
+            x->hdr[n++] = x->reg_address;
+        }
+    }
+    if (x->op != BBUS_I2C_MULTI_WRITE)
+    {
+        x->hdr[n++] = SEQ_START | ((addr & BBUS_I2C_ADDR_10BIT) ? hi : (addr & 0xFE)) | 0x01;
+    }
+    x->hdr_n = n;
+    x->result = 0;
+    x->state = M_START_A;
+    x->sym = 0;
+    x->clk = 0;
+    x->sr = 0;
+    x->sync = 0;
+    x->half = bbus_i2c_get_delay_time(x->lun) * BBUS_I2C_CYCLES_PER_US;
+}
+
+/**
+ * @brief       执行当前状态的引脚动作
+ * @param       x: 传输
+ * @retval      1，动作后需等待半周期；0，立即执行下一个状态
+ */
+static uint8_t multi_step(bbus_i2c_multi_xfer_t *x)
+{
+    uint8_t lun = x->lun;
+
+    switch (x->state)
+    {
+    case M_START_A:
+        bbus_i2c_line_sda(lun, 1);
+        bbus_i2c_line_scl(lun, 1);
+        x->sync = 1;
+        x->state = M_START_B;
+        return 1;
+
+    case M_START_B:
+        bbus_i2c_line_sda(lun, 0);
+        x->clk = 0;
+        x->sr = 0;
+        x->state = M_BIT_A;
+        return 1;
+
+    case M_BIT_A:
+        if (multi_sym_is_tx(x))
+        {
+            bbus_i2c_line_scl(lun, 0);
+            if (x->clk < 8)
+            {
+                bbus_i2c_line_sda(lun, (uint8_t)((multi_sym_byte(x) >> (7 - x->clk)) & 1u));
+            }
+            else
+            {
+                bbus_i2c_line_sda_release(lun); /* 第9个时钟：释放SDA等待应答 */
+            }
+        }
+        else
+        {
+            if (x->clk > 0)
+            {
+                x->sr = (uint8_t)((x->sr << 1) | bbus_i2c_line_sda_get(lun)); /* SCL高电平结束前采样 */
+            }
+            bbus_i2c_line_scl(lun, 0);
+            if (x->clk < 8)
+            {
+                bbus_i2c_line_sda_release(lun);
+            }
+            else
+            {
+                /* 第9个时钟：非最后一个字节发送ACK，最后一个字节发送NACK */
+                bbus_i2c_line_sda(lun, (uint8_t)(x->sym + 1 == x->hdr_n + x->len));
+            }
+        }
+        x->state = M_BIT_B;
+        return 1;
+
+    case M_BIT_B:
+        bbus_i2c_line_scl(lun, 1);
+        x->sync = 1;
+        x->state = (++x->clk == 9) ? M_NEXT : M_BIT_A;
+        return 1;
+
+    case M_NEXT:
+        if (multi_sym_is_tx(x))
+        {
+            if (bbus_i2c_line_sda_get(lun))
+            {
+                BBUS_I2C_LOG("[I2C Multi][ERROR]: Wait ACK failed on bus %d, address 0x%02X\n", lun, x->slave_addr);
+                x->result = 1; // 接收应答失败
+                x->state = M_STOP_A;
+                return 0;
+            }
+        }
+        else
+        {
+            x->data[x->sym - x->hdr_n] = x->sr;
+        }
+        x->sym++;
+        x->clk = 0;
+        x->sr = 0;
+        if (x->sym == x->hdr_n + x->len)
+        {
+            x->state = M_STOP_A;
+        }
+        else if (x->sym < x->hdr_n && (x->hdr[x->sym] & SEQ_START))
+        {
+            x->state = M_RSTART;
+        }
+        else
+        {
+            x->state = M_BIT_A;
+        }
+        return 0;
+
+    case M_RSTART:
+        bbus_i2c_line_scl(lun, 0);
+        bbus_i2c_line_sda(lun, 1);
+        x->state = M_START_A;
+        return 1;
+
+    case M_STOP_A:
+        bbus_i2c_line_scl(lun, 0);
+        bbus_i2c_line_sda(lun, 0);
+        x->state = M_STOP_B;
+        return 1;
+
+    case M_STOP_B:
+        bbus_i2c_line_scl(lun, 1);
+        x->sync = 1;
+        x->state = M_STOP_C;
+        return 1;
+
+    case M_STOP_C:
+        bbus_i2c_line_sda(lun, 1);
+        x->state = M_DONE;
+        return 1;
+
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief       在多条总线上同时执行传输
+ * @param       xfers: 传输数组
+ * @param       count: 传输数量
+ * @param       timeout: 整体超时时间ms
+ * @retval      0，全部成功；1，至少一条失败(查看各条目的 result)
+ */
+uint8_t bbus_i2c_multi_run(bbus_i2c_multi_xfer_t *xfers, uint8_t count, uint32_t timeout)
+{
+    uint32_t wait_time = bbus_i2c_port_tick_get();
+    uint8_t active = 0, locked, ret = 0;
+    uint32_t now;
+
+    // 截止时间全部基于周期计数器：端口未实现(恒返回0)时任何总线都不会到期，直接拒绝
+    now = bbus_i2c_port_cycle_get();
+    bbus_i2c_port_delay_us(1);
+    if (bbus_i2c_port_cycle_get() == now)
+    {
+        BBUS_I2C_LOG("[I2C Multi][ERROR]: bbus_i2c_port_cycle_get is not running\n");
+        for (uint8_t i = 0; i < count; i++)
+        {
+            xfers[i].result = 1;
+        }
+        return 1;
+    }
+
+    for (locked = 0; locked < count; locked++)
+    {
+        if (bbus_i2c_lock(xfers[locked].lun, timeout))
+        {
+            BBUS_I2C_LOG("[I2C Multi][ERROR]: Bus %d busy\n", xfers[locked].lun);
+            ret = 1;
+            break;
+        }
+    }
+
+    if (ret == 0)
+    {
+        now = bbus_i2c_port_cycle_get();
+        for (uint8_t i = 0; i < count; i++)
+        {
+            multi_prepare(&xfers[i]);
+            xfers[i].deadline = now;
+        }
+        active = count;
+    }
+
+    while (active)
+    {
+        bbus_i2c_multi_xfer_t *next = 0;
+
+        now = bbus_i2c_port_cycle_get();
+        for (uint8_t i = 0; i < count; i++)
+        {
+            bbus_i2c_multi_xfer_t *x = &xfers[i];
+
+            if (x->state == M_DONE)
+            {
+                continue;
+            }
+            if (x->sync)
+            {
+                /* SCL释放后回读到高电平才开始计算高电平时间，兼容时钟延展与慢上升沿 */
+                if (!bbus_i2c_line_scl_get(x->lun))
+                {
+                    continue;
+                }
+                x->sync = 0;
+                x->deadline = now + x->half;
+            }
+            if (next == 0 || (int32_t)(x->deadline - next->deadline) < 0)
+            {
+                next = x;
+            }
+        }
+
+        if (next == 0 || (int32_t)(now - next->deadline) < 0)
+        {
+            /* 没有到期的总线：检查整体超时后继续轮询 */
+            if ((bbus_i2c_port_tick_get() - wait_time) >= timeout)
+            {
+                break;
+            }
+            continue;
+        }
+
+        while (multi_step(next) == 0 && next->state != M_DONE)
+        {
+        }
+        next->deadline = now + next->half;
+        if (next->state == M_DONE)
+        {
+            active--;
+        }
+    }
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (i < locked)
+        {
+            if (active && xfers[i].state != M_DONE)
+            {
+                BBUS_I2C_LOG("[I2C Multi][ERROR]: Bus %d timeout\n", xfers[i].lun);
+                bbus_i2c_stop(xfers[i].lun); // 超时：强制产生停止信号
+                xfers[i].result = 1;
+            }
+            bbus_i2c_unlock(xfers[i].lun);
+        }
+        if (locked < count)
+        {
+            xfers[i].result = 1; // 未能锁定全部总线，所有传输均未开始
+        }
+        if (xfers[i].result)
+        {
+            ret = 1;
+        }
+    }
+    return ret;
+}
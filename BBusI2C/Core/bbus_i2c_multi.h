@@ -0,0 +1,75 @@
+/**
+ * @file    bbus_i2c_multi.h
+ * @version v1.0
+ * @date    2026-10-19
+ * @author  ZeroOneLab
+ * @website https://github.com/ZeroOneLab/BBusI2C.git
+ *
+ * @license MIT License
+ * Copyright (c) 2026 ZeroOneLab
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BBUS_I2C_MULTI_H
+#define BBUS_I2C_MULTI_H
+
+#include "bbus_i2c.h"
+
+/* 传输类型 */
+#define BBUS_I2C_MULTI_WRITE    0 // 等同 bbus_i2c_write_data
+#define BBUS_I2C_MULTI_READ     1 // 等同 bbus_i2c_read_data
+#define BBUS_I2C_MULTI_READ_SEQ 2 // 等同 bbus_i2c_read_seq
+
+/* 单条总线上的一次传输，各条目的 lun 必须互不相同 */
+typedef struct
+{
+    uint8_t lun;         /* I2C总线号 */
+    uint8_t op;          /* 传输类型 BBUS_I2C_MULTI_xxx */
+    uint16_t slave_addr; /* 从设备地址 */
+    uint8_t reg_address; /* 寄存器地址(BBUS_I2C_MULTI_READ_SEQ 时忽略) */
+    uint8_t *data;       /* 数据缓冲区 */
+    uint8_t len;         /* 数据长度 */
+    uint8_t result;      /* 执行结果，0：成功；1：失败 */
+
+    /* 以下为引擎内部状态 */
+    uint8_t state;
+    uint8_t clk;
+    uint8_t sym;
+    uint8_t hdr_n;
+    uint8_t sr;
+    uint8_t sync;
+    uint16_t hdr[4];
+    uint32_t half;
+    uint32_t deadline;
+} bbus_i2c_multi_xfer_t;
+
+/**
+ * @brief       在多条总线上同时执行传输
+ * @note        单核协作式调度：把每条总线的半周期延时视为截止时间，一条总线等待时推进其他
+ *              已到期总线的时钟沿，K条总线的传输总耗时约等于其中最长的一条，而非K条之和。
+ *              延时基于 bbus_i2c_port_cycle_get 与 BBUS_I2C_CYCLES_PER_US，周期计数器未运行时直接返回失败
+ * @param       xfers: 传输数组
+ * @param       count: 传输数量
+ * @param       timeout: 整体超时时间ms
+ * @retval      0，全部成功；1，至少一条失败(查看各条目的 result)
+ */
+uint8_t bbus_i2c_multi_run(bbus_i2c_multi_xfer_t *xfers, uint8_t count, uint32_t timeout);
+
+#endif
@@ -0,0 +1,251 @@
+/**
+ * @file    bbus_i2c_pmbus.c
+ * @version v1.0
+ * @date    2026-10-19
+ * @author  ZeroOneLab
+ * @website https://github.com/ZeroOneLab/BBusI2C.git
+ *
+ * @license MIT License
+ * Copyright (c) 2026 ZeroOneLab
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "bbus_i2c_pmbus.h"
+
+/**
+ * @brief       尾数 × 1000 × 2^exponent，饱和到int32
+ * @param       mantissa: 尾数
+ * @param       exponent: 指数
+ * @retval      数值 × 1000
+ */
+static int32_t bbus_i2c_pmbus_scale(int32_t mantissa, int8_t exponent)
+{
+    int64_t v = (int64_t)mantissa * 1000;
+
+    if (exponent >= 0)
+    {
+        v <<= exponent;
+    }
+    else
+    {
+        v = (v + ((int64_t)1 << (-exponent - 1))) >> -exponent; // 四舍五入
+    }
+    if (v > INT32_MAX)
+    {
+        return INT32_MAX;
+    }
+    if (v < INT32_MIN)
+    {
+        return INT32_MIN;
+    }
+    return (int32_t)v;
+}
+
+/**
+ * @brief       LINEAR11转换为千分之一单位的定点数
+ * @param       raw: 原始字
+ * @retval      数值 × 1000
+ */
+int32_t bbus_i2c_pmbus_linear11(uint16_t raw)
+{
+    int8_t exponent = (int8_t)((int8_t)(raw >> 8) >> 3);    // 高5位，符号扩展
+    int16_t mantissa = (int16_t)((int16_t)(raw << 5) >> 5); // 低11位，符号扩展
+
+    return bbus_i2c_pmbus_scale(mantissa, exponent);
+}
+
+/**
+ * @brief       LINEAR16转换为千分之一单位的定点数
+ * @param       raw: 原始字(无符号尾数)
+ * @param       exponent: VOUT_MODE中的指数(-16~15)
+ * @retval      数值 × 1000
+ */
+int32_t bbus_i2c_pmbus_linear16(uint16_t raw, int8_t exponent)
+{
+    return bbus_i2c_pmbus_scale(raw, exponent);
+}
+
+/**
+ * @brief       初始化电源轨
+ * @param       rail: 电源轨
+ * @param       lun: I2C总线号
+ * @param       slave_addr: 设备地址
+ * @param       page: PAGE号，BBUS_I2C_PMBUS_NO_PAGE表示不切换
+ * @retval      无
+ */
+void bbus_i2c_pmbus_rail_init(bbus_i2c_pmbus_rail_t *rail, uint8_t lun, uint8_t slave_addr, uint8_t page)
+{
+    rail->lun = lun;
+    rail->slave_addr = slave_addr;
+    rail->page = page;
+    rail->vout_exp = 0;
+    rail->vout_valid = 0;
+}
+
+/**
+ * @brief       初始化遥测扫描
+ * @param       sweep: 扫描
+ * @param       rails: 电源轨数组
+ * @param       rail_num: 电源轨数量
+ * @param       cmds: 遥测命令数组
+ * @param       cmd_num: 命令数量
+ * @param       values: 结果缓冲区，至少 rail_num*cmd_num 个
+ * @param       cmd_us: 各命令耗时缓冲区，至少 cmd_num 个，可为NULL
+ * @retval      无
+ */
+void bbus_i2c_pmbus_sweep_init(bbus_i2c_pmbus_sweep_t *sweep, bbus_i2c_pmbus_rail_t *rails, uint8_t rail_num,
+                               const bbus_i2c_pmbus_cmd_t *cmds, uint8_t cmd_num, int32_t *values, uint32_t *cmd_us)
+{
+    sweep->rails = rails;
+    sweep->rail_num = rail_num;
+    sweep->cmds = cmds;
+    sweep->cmd_num = cmd_num;
+    sweep->values = values;
+    sweep->cmd_us = cmd_us;
+    sweep->sweep_us = 0;
+    sweep->sweep_max_us = 0;
+    sweep->errors = 0;
+    sweep->sweeps = 0;
+    for (uint16_t i = 0; i < (uint16_t)rail_num * cmd_num; i++)
+    {
+        values[i] = 0;
+    }
+}
+
+/**
+ * @brief       扫描一个电源轨：切换PAGE后依次读取全部命令
+ * @param       sweep: 扫描
+ * @param       r: 电源轨序号
+ * @param       timeout: 单次传输超时时间ms
+ * @retval      失败的读取次数
+ */
+static uint8_t bbus_i2c_pmbus_sweep_rail(bbus_i2c_pmbus_sweep_t *sweep, uint8_t r, uint32_t timeout)
+{
+    bbus_i2c_pmbus_rail_t *rail = &sweep->rails[r];
+    int32_t *values = &sweep->values[(uint16_t)r * sweep->cmd_num];
+    uint8_t fail = 0, mode;
+    uint16_t raw;
+    uint32_t t0, t1;
+
+    if (rail->page != BBUS_I2C_PMBUS_NO_PAGE &&
+        bbus_i2c_smbus_write_byte(rail->lun, rail->slave_addr, BBUS_I2C_PMBUS_PAGE, rail->page, timeout))
+    {
+        BBUS_I2C_LOG("[I2C PMBus][ERROR]: Set PAGE %d failed for address 0x%02X\n", rail->page, rail->slave_addr);
+        return sweep->cmd_num; // PAGE未切换，读到的会是其他PAGE的数据
+    }
+    if (!rail->vout_valid)
+    {
+        for (uint8_t i = 0; i < sweep->cmd_num; i++)
+        {
+            if (sweep->cmds[i].format == BBUS_I2C_PMBUS_FMT_LINEAR16)
+            {
+                if (bbus_i2c_smbus_read_byte(rail->lun, rail->slave_addr, BBUS_I2C_PMBUS_VOUT_MODE, &mode, timeout) == 0)
+                {
+                    rail->vout_exp = (int8_t)((int8_t)(mode << 3) >> 3); // 低5位，符号扩展
+                    rail->vout_valid = 1;
+                }
+                break;
+            }
+        }
+    }
+    t0 = bbus_i2c_port_cycle_get();
+    for (uint8_t i = 0; i < sweep->cmd_num; i++)
+    {
+        const bbus_i2c_pmbus_cmd_t *cmd = &sweep->cmds[i];
+
+        if (bbus_i2c_smbus_read_word(rail->lun, rail->slave_addr, cmd->command, &raw, timeout) ||
+            (cmd->format == BBUS_I2C_PMBUS_FMT_LINEAR16 && !rail->vout_valid))
+        {
+            fail++;
+        }
+        else if (cmd->format == BBUS_I2C_PMBUS_FMT_LINEAR11)
+        {
+            values[i] = bbus_i2c_pmbus_linear11(raw);
+        }
+        else if (cmd->format == BBUS_I2C_PMBUS_FMT_LINEAR16)
+        {
+            values[i] = bbus_i2c_pmbus_linear16(raw, rail->vout_exp);
+        }
+        else
+        {
+            values[i] = raw;
+        }
+        t1 = bbus_i2c_port_cycle_get();
+        if (sweep->cmd_us)
+        {
+            sweep->cmd_us[i] += (t1 - t0) / BBUS_I2C_CYCLES_PER_US;
+        }
+        t0 = t1;
+    }
+    return fail;
+}
+
+/**
+ * @brief       执行一次遥测扫描
+ * @param       sweep: 扫描
+ * @param       timeout: 单次传输超时时间ms
+ * @retval      0，全部成功；1，存在失败的读取(对应结果保持上次的值)
+ * @note        同一电源轨的PAGE切换与全部命令在一次总线独占内完成，其他任务的传输不会插入导致PAGE被改写
+ */
+uint8_t bbus_i2c_pmbus_sweep_run(bbus_i2c_pmbus_sweep_t *sweep, uint32_t timeout)
+{
+    uint32_t start = bbus_i2c_port_cycle_get();
+    uint32_t fail = 0;
+
+    if (sweep->cmd_us)
+    {
+        for (uint8_t i = 0; i < sweep->cmd_num; i++)
+        {
+            sweep->cmd_us[i] = 0;
+        }
+    }
+    for (uint8_t r = 0; r < sweep->rail_num; r++)
+    {
+        uint8_t lun = sweep->rails[r].lun;
+
+        if (bbus_i2c_lock(lun, timeout))
+        {
+            fail += sweep->cmd_num;
+            continue;
+        }
+        fail += bbus_i2c_pmbus_sweep_rail(sweep, r, timeout);
+        bbus_i2c_unlock(lun);
+    }
+    sweep->sweep_us = (bbus_i2c_port_cycle_get() - start) / BBUS_I2C_CYCLES_PER_US;
+    if (sweep->sweep_us > sweep->sweep_max_us)
+    {
+        sweep->sweep_max_us = sweep->sweep_us;
+    }
+    sweep->errors += fail;
+    sweep->sweeps++;
+    return fail ? 1 : 0;
+}
+
+/**
+ * @brief       获取扫描结果
+ * @param       sweep: 扫描
+ * @param       rail: 电源轨序号
+ * @param       cmd: 命令序号
+ * @retval      结果
+ */
+int32_t bbus_i2c_pmbus_get(const bbus_i2c_pmbus_sweep_t *sweep, uint8_t rail, uint8_t cmd)
+{
+    return sweep->values[(uint16_t)rail * sweep->cmd_num + cmd];
+}
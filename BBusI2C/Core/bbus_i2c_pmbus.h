@@ -0,0 +1,145 @@
+/**
+ * @file    bbus_i2c_pmbus.h
+ * @version v1.0
+ * @date    2026-10-19
+ * @author  ZeroOneLab
+ * @website https://github.com/ZeroOneLab/BBusI2C.git
+ *
+ * @license MIT License
+ * Copyright (c) 2026 ZeroOneLab
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BBUS_I2C_PMBUS_H
+#define BBUS_I2C_PMBUS_H
+
+#include "bbus_i2c_smbus.h"
+
+/* 常用PMBus命令码 */
+#define BBUS_I2C_PMBUS_PAGE               0x00
+#define BBUS_I2C_PMBUS_VOUT_MODE          0x20
+#define BBUS_I2C_PMBUS_STATUS_BYTE        0x78
+#define BBUS_I2C_PMBUS_STATUS_WORD        0x79
+#define BBUS_I2C_PMBUS_READ_VIN           0x88
+#define BBUS_I2C_PMBUS_READ_IIN           0x89
+#define BBUS_I2C_PMBUS_READ_VOUT          0x8B
+#define BBUS_I2C_PMBUS_READ_IOUT          0x8C
+#define BBUS_I2C_PMBUS_READ_TEMPERATURE_1 0x8D
+#define BBUS_I2C_PMBUS_READ_TEMPERATURE_2 0x8E
+#define BBUS_I2C_PMBUS_READ_POUT          0x96
+#define BBUS_I2C_PMBUS_READ_PIN           0x97
+
+#define BBUS_I2C_PMBUS_NO_PAGE 0xFF // 电源轨不使用PAGE命令
+
+/* 数据格式 */
+#define BBUS_I2C_PMBUS_FMT_RAW      0 // 原始字，不做转换(如STATUS_WORD)
+#define BBUS_I2C_PMBUS_FMT_LINEAR11 1 // 5位指数 + 11位尾数
+#define BBUS_I2C_PMBUS_FMT_LINEAR16 2 // 16位无符号尾数，指数取自VOUT_MODE(READ_VOUT)
+
+/* 电源轨：一个PMBus设备上的一个PAGE */
+typedef struct
+{
+    uint8_t lun;        /* I2C总线号 */
+    uint8_t slave_addr; /* 设备地址 */
+    uint8_t page;       /* PAGE号，BBUS_I2C_PMBUS_NO_PAGE表示不切换 */
+    int8_t vout_exp;    /* LINEAR16指数，首次扫描时从VOUT_MODE读取 */
+    uint8_t vout_valid; /* vout_exp 是否已读取 */
+} bbus_i2c_pmbus_rail_t;
+
+/* 遥测命令 */
+typedef struct
+{
+    uint8_t command; /* 命令码 */
+    uint8_t format;  /* BBUS_I2C_PMBUS_FMT_xxx */
+} bbus_i2c_pmbus_cmd_t;
+
+/* 遥测扫描：rail_num 个电源轨 × cmd_num 条命令 */
+typedef struct
+{
+    bbus_i2c_pmbus_rail_t *rails;
+    uint8_t rail_num;
+    const bbus_i2c_pmbus_cmd_t *cmds;
+    uint8_t cmd_num;
+    int32_t *values;   /* rail_num*cmd_num 个结果，按电源轨依次排列；LINEAR格式为千分之一单位(mV/mA/m℃/mW)，RAW为原始字 */
+    uint32_t *cmd_us;  /* cmd_num 个，最近一次扫描中各命令在所有电源轨上的累计耗时(us)，可为NULL */
+    uint32_t sweep_us; /* 最近一次扫描总耗时(us) */
+    uint32_t sweep_max_us; /* 历次扫描的最大耗时(us) */
+    uint32_t errors;   /* 累计失败的读取次数 */
+    uint32_t sweeps;   /* 扫描次数 */
+} bbus_i2c_pmbus_sweep_t;
+
+/**
+ * @brief       LINEAR11转换为千分之一单位的定点数
+ * @param       raw: 原始字
+ * @retval      数值 × 1000
+ */
+int32_t bbus_i2c_pmbus_linear11(uint16_t raw);
+
+/**
+ * @brief       LINEAR16转换为千分之一单位的定点数
+ * @param       raw: 原始字(无符号尾数)
+ * @param       exponent: VOUT_MODE中的指数(-16~15)
+ * @retval      数值 × 1000
+ */
+int32_t bbus_i2c_pmbus_linear16(uint16_t raw, int8_t exponent);
+
+/**
+ * @brief       初始化电源轨
+ * @param       rail: 电源轨
+ * @param       lun: I2C总线号
+ * @param       slave_addr: 设备地址
+ * @param       page: PAGE号，BBUS_I2C_PMBUS_NO_PAGE表示不切换
+ * @retval      无
+ */
+void bbus_i2c_pmbus_rail_init(bbus_i2c_pmbus_rail_t *rail, uint8_t lun, uint8_t slave_addr, uint8_t page);
+
+/**
+ * @brief       初始化遥测扫描
+ * @param       sweep: 扫描
+ * @param       rails: 电源轨数组
+ * @param       rail_num: 电源轨数量
+ * @param       cmds: 遥测命令数组
+ * @param       cmd_num: 命令数量
+ * @param       values: 结果缓冲区，至少 rail_num*cmd_num 个
+ * @param       cmd_us: 各命令耗时缓冲区，至少 cmd_num 个，可为NULL
+ * @retval      无
+ */
+void bbus_i2c_pmbus_sweep_init(bbus_i2c_pmbus_sweep_t *sweep, bbus_i2c_pmbus_rail_t *rails, uint8_t rail_num,
+                               const bbus_i2c_pmbus_cmd_t *cmds, uint8_t cmd_num, int32_t *values, uint32_t *cmd_us);
+
+/**
+ * @brief       执行一次遥测扫描
+ * @param       sweep: 扫描
+ * @param       timeout: 单次传输超时时间ms
+ * @retval      0，全部成功；1，存在失败的读取(对应结果保持上次的值)
+ * @note        同一电源轨的PAGE切换与全部命令在一次总线独占内完成，其他任务的传输不会插入导致PAGE被改写
+ */
+uint8_t bbus_i2c_pmbus_sweep_run(bbus_i2c_pmbus_sweep_t *sweep, uint32_t timeout);
+
+/**
+ * @brief       获取扫描结果
+ * @param       sweep: 扫描
+ * @param       rail: 电源轨序号
+ * @param       cmd: 命令序号
+ * @retval      结果
+ */
+int32_t bbus_i2c_pmbus_get(const bbus_i2c_pmbus_sweep_t *sweep, uint8_t rail, uint8_t cmd);
+
+#endif
@@ -29,8 +29,24 @@
 
 #include "bbus_i2c_port.h"
 
+#if (BBUS_I2C_OS == BBUS_I2C_OS_POSIX)
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+#else
 #include "main.h"
 #include "delay.h"
+#endif
+
+#if (BBUS_I2C_OS == BBUS_I2C_OS_FREERTOS)
+#include "FreeRTOS.h"
+#include "semphr.h"
+
+static StaticSemaphore_t bus_mutex_buf[BBUS_I2C_BUS_NUM];
+static SemaphoreHandle_t bus_mutex[BBUS_I2C_BUS_NUM];
+#elif (BBUS_I2C_OS == BBUS_I2C_OS_POSIX)
+static pthread_mutex_t bus_mutex[BBUS_I2C_BUS_NUM];
+#endif
 
 /**
  * @brief   软件I2C延时函数
@@ -39,7 +55,13 @@
  */
 void bbus_i2c_port_delay_us(uint32_t xus)
 {
+#if (BBUS_I2C_OS == BBUS_I2C_OS_POSIX)
+    struct timespec ts = {(time_t)(xus / 1000000u), (long)(xus % 1000000u) * 1000L};
 
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR)
+    {
+    }
+#endif
 }
 
 /**
@@ -49,7 +71,29 @@ void bbus_i2c_port_delay_us(uint32_t xus)
  */
 uint32_t bbus_i2c_port_tick_get(void)
 {
+#if (BBUS_I2C_OS == BBUS_I2C_OS_POSIX)
+    struct timespec ts;
 
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000u + ts.tv_nsec / 1000000);
+#endif
+}
+
+/**
+ * @brief   获取自由运行的周期计数器，用于统计关中断窗口等时长
+ * @param   无
+ * @retval  当前周期计数
+ */
+uint32_t bbus_i2c_port_cycle_get(void)
+{
+#if (BBUS_I2C_OS == BBUS_I2C_OS_POSIX)
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000000000u + ts.tv_nsec); /* 以纳秒计数 */
+#else
+    return 0;
+#endif
 }
 
 /**
@@ -59,6 +103,38 @@ uint32_t bbus_i2c_port_tick_get(void)
  */
 void bbus_i2c_port_init(uint8_t lun)
 {
+#if (BBUS_I2C_OS == BBUS_I2C_OS_FREERTOS)
+    /* 递归互斥量自带优先级继承，高优先级任务不会被持有总线的低优先级任务长期阻塞 */
+    bus_mutex[lun] = xSemaphoreCreateRecursiveMutexStatic(&bus_mutex_buf[lun]);
+#elif (BBUS_I2C_OS == BBUS_I2C_OS_POSIX)
+    pthread_mutexattr_t attr;
+
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutexattr_setprotocol(&attr, PTHREAD_PRIO_INHERIT);
+    pthread_mutex_init(&bus_mutex[lun], &attr);
+    pthread_mutexattr_destroy(&attr);
+#endif
+
+    switch (lun)
+    {
+    case 0:
+        break;
+    case 1:
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief   获取端口能力标志
+ * @param   lun: I2C总线号
+ * @retval  BBUS_I2C_PORT_CAP_xxx 的按位组合
+ */
+uint8_t bbus_i2c_port_get_caps(uint8_t lun)
+{
+    uint8_t caps = 0;
     switch (lun)
     {
     case 0:
@@ -68,6 +144,7 @@ void bbus_i2c_port_init(uint8_t lun)
     default:
         break;
     }
+    return caps;
 }
 
 /**
@@ -128,6 +205,27 @@ uint8_t bbus_i2c_port_sda_get(uint8_t lun)
     return ret;
 }
 
+/**
+ * @brief   获取I2C SCL引脚电平
+ * @note    仅在端口能力包含 BBUS_I2C_PORT_CAP_SCL_READ 时被调用
+ * @param   lun: I2C总线号
+ * @retval  SCL引脚电平，1：高电平，0：低电平
+ */
+uint8_t bbus_i2c_port_scl_get(uint8_t lun)
+{
+    uint8_t ret = 0;
+    switch (lun)
+    {
+    case 0:
+        break;
+    case 1:
+        break;
+    default:
+        break;
+    }
+    return ret;
+}
+
 /**
  * @brief   设置I2C SDA引脚为输出模式
  * @param   lun: I2C总线号
@@ -164,6 +262,27 @@ void bbus_i2c_port_sda_set_in(uint8_t lun)
     }
 }
 
+#if BBUS_I2C_USE_PUSH_PULL
+/**
+ * @brief   切换I2C引脚驱动方式
+ * @param   lun: I2C总线号
+ * @param   push_pull: 1：推挽，0：恢复开漏
+ * @retval  无
+ */
+void bbus_i2c_port_set_drive(uint8_t lun, uint8_t push_pull)
+{
+    switch (lun)
+    {
+    case 0:
+        break;
+    case 1:
+        break;
+    default:
+        break;
+    }
+}
+#endif
+
 /**
  * @brief   进入临界区
  * @param   lun: I2C总线号
@@ -199,3 +318,88 @@ void bbus_i2c_port_exit_critical(uint8_t lun)
         break;
     }
 }
+
+/**
+ * @brief   获取总线互斥锁，保证一次传输期间总线被独占
+ * @note    互斥锁必须可递归获取，以支持 bbus_i2c_lock 包裹多次传输
+ * @param   lun: I2C总线号
+ * @param   timeout: 超时时间ms，BBUS_I2C_WAIT_FOREVER 表示永久等待
+ * @retval  0，获取成功；1，获取超时
+ */
+uint8_t bbus_i2c_port_mutex_take(uint8_t lun, uint32_t timeout)
+{
+#if (BBUS_I2C_OS == BBUS_I2C_OS_FREERTOS)
+    TickType_t ticks = (timeout == BBUS_I2C_WAIT_FOREVER) ? portMAX_DELAY : pdMS_TO_TICKS(timeout);
+
+    return (xSemaphoreTakeRecursive(bus_mutex[lun], ticks) == pdTRUE) ? 0 : 1;
+#elif (BBUS_I2C_OS == BBUS_I2C_OS_POSIX)
+    struct timespec ts;
+
+    if (timeout == BBUS_I2C_WAIT_FOREVER)
+    {
+        return (pthread_mutex_lock(&bus_mutex[lun]) == 0) ? 0 : 1;
+    }
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_sec += timeout / 1000u;
+    ts.tv_nsec += (long)(timeout % 1000u) * 1000000L;
+    if (ts.tv_nsec >= 1000000000L)
+    {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+    return (pthread_mutex_timedlock(&bus_mutex[lun], &ts) == 0) ? 0 : 1;
+#else
+    (void)lun;
+    (void)timeout;
+    return 0;
+#endif
+}
+
+/**
+ * @brief   释放总线互斥锁
+ * @param   lun: I2C总线号
+ * @retval  无
+ */
+void bbus_i2c_port_mutex_give(uint8_t lun)
+{
+#if (BBUS_I2C_OS == BBUS_I2C_OS_FREERTOS)
+    xSemaphoreGiveRecursive(bus_mutex[lun]);
+#elif (BBUS_I2C_OS == BBUS_I2C_OS_POSIX)
+    pthread_mutex_unlock(&bus_mutex[lun]);
+#else
+    (void)lun;
+#endif
+}
+
+#if BBUS_I2C_USE_PORT_MASK
+/**
+ * @brief   同时设置多条总线的SCL引脚电平
+ * @param   mask: 总线掩码，第n位对应总线n
+ * @param   level: SCL引脚电平，1：高电平，0：低电平
+ * @retval  无
+ */
+void bbus_i2c_port_scl_set_mask(uint32_t mask, uint8_t level)
+{
+}
+
+/**
+ * @brief   同时设置多条总线的SDA引脚电平
+ * @param   mask: 总线掩码，第n位对应总线n
+ * @param   level: SDA引脚电平，1：高电平，0：低电平
+ * @retval  无
+ */
+void bbus_i2c_port_sda_set_mask(uint32_t mask, uint8_t level)
+{
+}
+
+/**
+ * @brief   同时读取多条总线的SDA引脚电平
+ * @param   mask: 总线掩码，第n位对应总线n
+ * @retval  各总线SDA电平，第n位对应总线n
+ */
+uint32_t bbus_i2c_port_sda_get_mask(uint32_t mask)
+{
+    uint32_t ret = 0;
+    return ret;
+}
+#endif
@@ -0,0 +1,238 @@
+/**
+ * @file    bbus_i2c_probe.c
+ * @version v1.0
+ * @date    2026-10-19
+ * @author  ZeroOneLab
+ * @website https://github.com/ZeroOneLab/BBusI2C.git
+ *
+ * @license MIT License
+ * Copyright (c) 2026 ZeroOneLab
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "bbus_i2c_probe.h"
+#include "bbus_i2c_smbus.h"
+
+#define PROBE_MAX_LEN 16   /* 校验长度上限 */
+#define PROBE_MAGIC0  'B'  /* 导出记录标识 */
+#define PROBE_MAGIC1  'P'
+#define PROBE_VERSION 2    /* 导出记录格式版本，2：从设备地址扩展为16位 */
+
+/**
+ * @brief       在当前速率下校验一次
+ * @param       dev: 设备描述
+ * @param       cfg: 探测配置
+ * @param       seed: 草稿寄存器测试图样的种子
+ * @param       timeout: 超时时间ms
+ * @retval      0，校验通过；1，传输失败或数据不一致
+ */
+static uint8_t bbus_i2c_probe_check(bbus_i2c_dev_t *dev, const bbus_i2c_probe_cfg_t *cfg, uint8_t seed, uint32_t timeout)
+{
+    uint8_t pattern[PROBE_MAX_LEN], buf[PROBE_MAX_LEN];
+    const uint8_t *expect = cfg->expect;
+
+    if (expect == 0)
+    {
+        // 草稿寄存器：交替写入0x55/0xAA图样，覆盖每一位的0和1
+        for (uint8_t i = 0; i < cfg->len; i++)
+        {
+            pattern[i] = ((seed + i) & 1u) ? 0xAA : 0x55;
+        }
+        if (bbus_i2c_dev_write(dev, cfg->reg_address, pattern, cfg->len, timeout))
+        {
+            return 1;
+        }
+        expect = pattern;
+    }
+    if (bbus_i2c_dev_read(dev, cfg->reg_address, buf, cfg->len, timeout))
+    {
+        return 1;
+    }
+    for (uint8_t i = 0; i < cfg->len; i++)
+    {
+        if (buf[i] != expect[i])
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief       校验一档速率：连续 repeat 次全部通过才算可靠
+ * @param       dev: 设备描述
+ * @param       cfg: 探测配置
+ * @param       timeout: 超时时间ms
+ * @retval      0，可靠；1，不可靠
+ */
+static uint8_t bbus_i2c_probe_step(bbus_i2c_dev_t *dev, const bbus_i2c_probe_cfg_t *cfg, uint32_t timeout)
+{
+    uint8_t repeat = cfg->repeat ? cfg->repeat : 1;
+
+    for (uint8_t i = 0; i < repeat; i++)
+    {
+        if (bbus_i2c_probe_check(dev, cfg, i, timeout))
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief       探测设备的最高可靠速率
+ * @param       dev: 设备描述
+ * @param       cfg: 探测配置
+ * @param       rec: 探测结果
+ * @param       timeout: 单次传输超时时间ms
+ * @retval      0，探测成功；1，起始速率即校验失败
+ */
+uint8_t bbus_i2c_probe_run(bbus_i2c_dev_t *dev, const bbus_i2c_probe_cfg_t *cfg, bbus_i2c_probe_rec_t *rec, uint32_t timeout)
+{
+    uint8_t saved[PROBE_MAX_LEN];
+    uint8_t retries = dev->retries;
+    uint32_t delay_time = dev->delay_time;
+    uint8_t ret = 0, restore = 0;
+
+    if (cfg->len == 0 || cfg->len > PROBE_MAX_LEN)
+    {
+        return 1;
+    }
+
+    // 探测期间关闭重试，否则重试会掩盖临界速率下的错误
+    dev->retries = 0;
+    dev->delay_time = cfg->start_delay;
+    if (cfg->expect == 0)
+    {
+        if (bbus_i2c_dev_read(dev, cfg->reg_address, saved, cfg->len, timeout))
+        {
+            ret = 1;
+        }
+        else
+        {
+            restore = 1; // 读到原值后，无论探测成败都要写回
+        }
+    }
+    if (ret || bbus_i2c_probe_step(dev, cfg, timeout))
+    {
+        BBUS_I2C_LOG("[I2C Probe][ERROR]: Address 0x%04X failed at start delay %lu us\n", dev->slave_addr, (unsigned long)cfg->start_delay);
+        ret = 1;
+    }
+    else
+    {
+        rec->fastest = cfg->start_delay;
+        while (rec->fastest > 0)
+        {
+            dev->delay_time = rec->fastest - 1;
+            if (bbus_i2c_probe_step(dev, cfg, timeout))
+            {
+                break;
+            }
+            rec->fastest--;
+        }
+        rec->lun = dev->lun;
+        rec->slave_addr = dev->slave_addr;
+        rec->delay_time = rec->fastest + cfg->margin;
+        if (rec->delay_time > cfg->start_delay)
+        {
+            rec->delay_time = cfg->start_delay;
+        }
+        delay_time = rec->delay_time;
+    }
+    if (restore)
+    {
+        // 恢复草稿寄存器原值：起始速率校验失败时图样也可能已经写入
+        dev->delay_time = cfg->start_delay;
+        bbus_i2c_dev_write(dev, cfg->reg_address, saved, cfg->len, timeout);
+    }
+
+    dev->retries = retries;
+    dev->delay_time = delay_time;
+    return ret;
+}
+
+static void bbus_i2c_probe_put32(uint8_t *buf, uint32_t value)
+{
+    buf[0] = (uint8_t)value;
+    buf[1] = (uint8_t)(value >> 8);
+    buf[2] = (uint8_t)(value >> 16);
+    buf[3] = (uint8_t)(value >> 24);
+}
+
+static uint32_t bbus_i2c_probe_get32(const uint8_t *buf)
+{
+    return (uint32_t)buf[0] | ((uint32_t)buf[1] << 8) | ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24);
+}
+
+/**
+ * @brief       导出探测结果为字节序列(小端，带校验)，用于保存到Flash/EEPROM
+ * @note        格式：'B' 'P' 版本 总线号 地址 fastest(4) delay_time(4) CRC-8(与SMBus PEC相同，由 bbus_i2c_smbus_pec 计算)
+ * @param       rec: 探测结果
+ * @param       buf: 输出缓冲区，BBUS_I2C_PROBE_REC_SIZE 字节
+ * @retval      无
+ */
+void bbus_i2c_probe_export(const bbus_i2c_probe_rec_t *rec, uint8_t *buf)
+{
+    buf[0] = PROBE_MAGIC0;
+    buf[1] = PROBE_MAGIC1;
+    buf[2] = PROBE_VERSION;
+    buf[3] = rec->lun;
+    buf[4] = (uint8_t)rec->slave_addr;
+    buf[5] = (uint8_t)(rec->slave_addr >> 8);
+    bbus_i2c_probe_put32(&buf[6], rec->fastest);
+    bbus_i2c_probe_put32(&buf[10], rec->delay_time);
+    buf[14] = bbus_i2c_smbus_pec(0, buf, BBUS_I2C_PROBE_REC_SIZE - 1);
+}
+
+/**
+ * @brief       导入保存的探测结果
+ * @param       buf: BBUS_I2C_PROBE_REC_SIZE 字节的记录
+ * @param       rec: 探测结果
+ * @retval      0，导入成功；1，记录无效(格式或校验错误)
+ */
+uint8_t bbus_i2c_probe_import(const uint8_t *buf, bbus_i2c_probe_rec_t *rec)
+{
+    if (buf[0] != PROBE_MAGIC0 || buf[1] != PROBE_MAGIC1 || buf[2] != PROBE_VERSION ||
+        buf[14] != bbus_i2c_smbus_pec(0, buf, BBUS_I2C_PROBE_REC_SIZE - 1))
+    {
+        return 1;
+    }
+    rec->lun = buf[3];
+    rec->slave_addr = (uint16_t)(buf[4] | (buf[5] << 8));
+    rec->fastest = bbus_i2c_probe_get32(&buf[6]);
+    rec->delay_time = bbus_i2c_probe_get32(&buf[10]);
+    return 0;
+}
+
+/**
+ * @brief       把探测结果应用到设备
+ * @param       dev: 设备描述
+ * @param       rec: 探测结果
+ * @retval      0，应用成功；1，记录与设备的总线号或地址不符
+ */
+uint8_t bbus_i2c_probe_apply(bbus_i2c_dev_t *dev, const bbus_i2c_probe_rec_t *rec)
+{
+    if (rec->lun != dev->lun || rec->slave_addr != dev->slave_addr)
+    {
+        return 1;
+    }
+    dev->delay_time = rec->delay_time;
+    return 0;
+}
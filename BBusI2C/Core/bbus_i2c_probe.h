@@ -0,0 +1,94 @@
+/**
+ * @file    bbus_i2c_probe.h
+ * @version v1.0
+ * @date    2026-10-19
+ * @author  ZeroOneLab
+ * @website https://github.com/ZeroOneLab/BBusI2C.git
+ *
+ * @license MIT License
+ * Copyright (c) 2026 ZeroOneLab
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BBUS_I2C_PROBE_H
+#define BBUS_I2C_PROBE_H
+
+#include "bbus_i2c_dev.h"
+
+#define BBUS_I2C_PROBE_REC_SIZE 15 // 导出记录的字节数
+
+/* 探测配置 */
+typedef struct
+{
+    uint16_t reg_address;  /* 校验寄存器 */
+    const uint8_t *expect; /* 只读寄存器(如ID)的期望值；为NULL时向该寄存器写入测试图样并回读(草稿寄存器) */
+    uint8_t len;           /* 校验长度，1~16 */
+    uint8_t repeat;        /* 每一档速率的重复校验次数 */
+    uint32_t start_delay;  /* 起始(最慢)半周期延时(us)，该档必须校验通过 */
+    uint32_t margin;       /* 安全余量：在最快可靠延时上增加的延时(us) */
+} bbus_i2c_probe_cfg_t;
+
+/* 探测结果，可导出保存，下次上电直接应用 */
+typedef struct
+{
+    uint8_t lun;         /* I2C总线号 */
+    uint16_t slave_addr; /* 从设备地址，10位地址含 BBUS_I2C_ADDR_10BIT 标志 */
+    uint32_t fastest;    /* 最快的可靠半周期延时(us) */
+    uint32_t delay_time; /* 推荐使用的半周期延时(us)，含安全余量 */
+} bbus_i2c_probe_rec_t;
+
+/**
+ * @brief       探测设备的最高可靠速率
+ * @note        从 start_delay 开始逐档减小半周期延时(每档1us)，每档重复校验 repeat 次，
+ *              遇到第一档失败即停止；探测期间关闭设备重试，结束后把推荐速率写入设备。
+ *              草稿寄存器模式下，结束后恢复寄存器原值
+ * @param       dev: 设备描述
+ * @param       cfg: 探测配置
+ * @param       rec: 探测结果
+ * @param       timeout: 单次传输超时时间ms
+ * @retval      0，探测成功；1，起始速率即校验失败
+ */
+uint8_t bbus_i2c_probe_run(bbus_i2c_dev_t *dev, const bbus_i2c_probe_cfg_t *cfg, bbus_i2c_probe_rec_t *rec, uint32_t timeout);
+
+/**
+ * @brief       导出探测结果为字节序列(小端，带校验)，用于保存到Flash/EEPROM
+ * @param       rec: 探测结果
+ * @param       buf: 输出缓冲区，BBUS_I2C_PROBE_REC_SIZE 字节
+ * @retval      无
+ */
+void bbus_i2c_probe_export(const bbus_i2c_probe_rec_t *rec, uint8_t *buf);
+
+/**
+ * @brief       导入保存的探测结果
+ * @param       buf: BBUS_I2C_PROBE_REC_SIZE 字节的记录
+ * @param       rec: 探测结果
+ * @retval      0，导入成功；1，记录无效(格式或校验错误)
+ */
+uint8_t bbus_i2c_probe_import(const uint8_t *buf, bbus_i2c_probe_rec_t *rec);
+
+/**
+ * @brief       把探测结果应用到设备
+ * @param       dev: 设备描述
+ * @param       rec: 探测结果
+ * @retval      0，应用成功；1，记录与设备的总线号或地址不符
+ */
+uint8_t bbus_i2c_probe_apply(bbus_i2c_dev_t *dev, const bbus_i2c_probe_rec_t *rec);
+
+#endif
@@ -0,0 +1,404 @@
+/**
+ * @file    bbus_i2c_regmap.c
+ * @version v1.0
+ * @date    2026-10-19
+ * @author  ZeroOneLab
+ * @website https://github.com/ZeroOneLab/BBusI2C.git
+ *
+ * @license MIT License
+ * Copyright (c) 2026 ZeroOneLab
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "bbus_i2c_regmap.h"
+
+/**
+ * @brief       获取寄存器在缓存中的下标
+ * @param       map: 寄存器缓存
+ * @param       reg_address: 寄存器地址
+ * @retval      缓存下标；寄存器不在缓存区间内时返回 map->num
+ */
+static inline uint16_t bbus_i2c_regmap_index(const bbus_i2c_regmap_t *map, uint16_t reg_address)
+{
+    uint16_t i = (uint16_t)(reg_address - map->base);
+
+    return (reg_address >= map->base && i < map->num) ? i : map->num;
+}
+
+/**
+ * @brief       判断寄存器是否可由缓存提供
+ * @param       map: 寄存器缓存
+ * @param       i: 缓存下标
+ * @param       now: 当前时间(ms)，用于判断限时缓存是否过期
+ * @retval      1，缓存可用；0，需要访问总线
+ */
+static inline uint8_t bbus_i2c_regmap_cached(const bbus_i2c_regmap_t *map, uint16_t i, uint32_t now)
+{
+    uint8_t flags;
+
+    if (i >= map->num)
+    {
+        return 0;
+    }
+    flags = map->flags[i];
+    if ((flags & (BBUS_I2C_REGMAP_VALID | BBUS_I2C_REGMAP_VOLATILE)) != BBUS_I2C_REGMAP_VALID)
+    {
+        return 0;
+    }
+    return !(flags & BBUS_I2C_REGMAP_TTL) || (now - map->stamp[i]) < map->ttl;
+}
+
+/**
+ * @brief       把从设备读取或写入设备的值存入缓存
+ * @param       map: 寄存器缓存
+ * @param       i: 缓存下标
+ * @param       val: 寄存器值
+ * @param       now: 当前时间(ms)
+ * @retval      无
+ */
+static inline void bbus_i2c_regmap_store(bbus_i2c_regmap_t *map, uint16_t i, uint8_t val, uint32_t now)
+{
+    if (i >= map->num || (map->flags[i] & BBUS_I2C_REGMAP_VOLATILE))
+    {
+        return;
+    }
+    map->cache[i] = val;
+    map->flags[i] |= BBUS_I2C_REGMAP_VALID;
+    if (map->flags[i] & BBUS_I2C_REGMAP_TTL)
+    {
+        map->stamp[i] = now;
+    }
+}
+
+static inline uint32_t bbus_i2c_regmap_now(const bbus_i2c_regmap_t *map)
+{
+    return map->stamp ? bbus_i2c_port_tick_get() : 0;
+}
+
+/**
+ * @brief       估算一次读取的总线耗时：起始/重复起始/停止信号 + (地址 + 寄存器地址 + 数据)每字节9个时钟
+ * @param       map: 寄存器缓存
+ * @param       len: 数据长度
+ * @retval      估算耗时(us)
+ */
+static uint32_t bbus_i2c_regmap_read_cost(const bbus_i2c_regmap_t *map, uint8_t len)
+{
+    uint32_t bytes = 2u + map->dev->reg_width + len;
+
+    return (bytes * 9u * 2u + 6u) * map->dev->delay_time;
+}
+
+/**
+ * @brief       初始化寄存器影子缓存，所有寄存器初始为无效、非易失
+ * @param       map: 寄存器缓存
+ * @param       dev: 设备描述
+ * @param       base: 第一个缓存寄存器的地址
+ * @param       num: 缓存寄存器数量
+ * @param       cache: 寄存器值缓存，num 字节
+ * @param       flags: 寄存器标志，num 字节
+ * @retval      无
+ */
+void bbus_i2c_regmap_init(bbus_i2c_regmap_t *map, bbus_i2c_dev_t *dev, uint16_t base, uint16_t num, uint8_t *cache, uint8_t *flags)
+{
+    map->dev = dev;
+    map->base = base;
+    map->num = num;
+    map->cache = cache;
+    map->flags = flags;
+    map->write_back = 0;
+    map->max_burst = 0;
+    map->ttl = 0;
+    map->stamp = 0;
+    map->hits = 0;
+    map->misses = 0;
+    map->saved_us = 0;
+    for (uint16_t i = 0; i < num; i++)
+    {
+        flags[i] = 0;
+    }
+}
+
+/**
+ * @brief       标记寄存器为易失/非易失
+ * @param       map: 寄存器缓存
+ * @param       reg_address: 寄存器地址
+ * @param       is_volatile: 1：易失，始终访问总线；0：非易失，可使用缓存
+ * @retval      无
+ */
+void bbus_i2c_regmap_set_volatile(bbus_i2c_regmap_t *map, uint16_t reg_address, uint8_t is_volatile)
+{
+    uint16_t i = bbus_i2c_regmap_index(map, reg_address);
+
+    if (i == map->num)
+    {
+        return;
+    }
+    if (is_volatile)
+    {
+        map->flags[i] |= BBUS_I2C_REGMAP_VOLATILE;
+    }
+    else
+    {
+        map->flags[i] &= (uint8_t)~BBUS_I2C_REGMAP_VOLATILE;
+    }
+}
+
+/**
+ * @brief       配置限时缓存
+ * @param       map: 寄存器缓存
+ * @param       ttl: 缓存有效时间(ms)
+ * @param       stamp: 各寄存器的缓存时刻，num 个元素
+ * @retval      无
+ */
+void bbus_i2c_regmap_set_ttl(bbus_i2c_regmap_t *map, uint32_t ttl, uint32_t *stamp)
+{
+    map->ttl = ttl;
+    map->stamp = stamp;
+}
+
+/**
+ * @brief       标记寄存器为限时缓存
+ * @param       map: 寄存器缓存
+ * @param       reg_address: 寄存器地址
+ * @param       enable: 1：缓存值仅在 ttl 内有效；0：普通缓存
+ * @retval      无
+ */
+void bbus_i2c_regmap_set_reg_ttl(bbus_i2c_regmap_t *map, uint16_t reg_address, uint8_t enable)
+{
+    uint16_t i = bbus_i2c_regmap_index(map, reg_address);
+
+    if (i == map->num || map->stamp == 0)
+    {
+        return;
+    }
+    if (enable)
+    {
+        map->flags[i] = (uint8_t)((map->flags[i] | BBUS_I2C_REGMAP_TTL) & ~BBUS_I2C_REGMAP_VALID);
+    }
+    else
+    {
+        map->flags[i] &= (uint8_t)~BBUS_I2C_REGMAP_TTL;
+    }
+}
+
+/**
+ * @brief       设置写回模式
+ * @param       map: 寄存器缓存
+ * @param       enable: 1：写回模式；0：写直达模式
+ * @param       max_burst: 单次连续写的最大字节数(设备页大小等)，0 表示不限制
+ * @retval      无
+ */
+void bbus_i2c_regmap_set_write_back(bbus_i2c_regmap_t *map, uint8_t enable, uint8_t max_burst)
+{
+    map->write_back = enable;
+    map->max_burst = max_burst;
+}
+
+/**
+ * @brief       把写回模式下已修改的寄存器写入设备
+ * @param       map: 寄存器缓存
+ * @param       timeout: 超时时间ms
+ * @retval      0，全部写入成功；1，写入失败(未写入的寄存器保持已修改状态)
+ */
+uint8_t bbus_i2c_regmap_flush(bbus_i2c_regmap_t *map, uint32_t timeout)
+{
+    uint8_t max = map->max_burst ? map->max_burst : 0xFF;
+    uint8_t ret = 0;
+    uint16_t i = 0;
+
+    if (bbus_i2c_lock(map->dev->lun, timeout))
+    {
+        return 1; // 获取总线失败
+    }
+    while (i < map->num)
+    {
+        uint8_t n = 0;
+
+        if (!(map->flags[i] & BBUS_I2C_REGMAP_DIRTY))
+        {
+            i++;
+            continue;
+        }
+        // 合并地址连续的已修改寄存器
+        while (i + n < map->num && n < max && (map->flags[i + n] & BBUS_I2C_REGMAP_DIRTY))
+        {
+            n++;
+        }
+        map->misses++;
+        if (bbus_i2c_dev_write(map->dev, (uint16_t)(map->base + i), &map->cache[i], n, timeout))
+        {
+            BBUS_I2C_LOG("[I2C Regmap][ERROR]: Flush failed at register 0x%04X\n", map->base + i);
+            ret = 1;
+            break;
+        }
+        for (uint8_t j = 0; j < n; j++)
+        {
+            map->flags[i + j] &= (uint8_t)~BBUS_I2C_REGMAP_DIRTY;
+        }
+        i += n;
+    }
+    bbus_i2c_unlock(map->dev->lun);
+
+    return ret;
+}
+
+/**
+ * @brief       使全部缓存失效，设备复位后调用
+ * @param       map: 寄存器缓存
+ * @retval      无
+ */
+void bbus_i2c_regmap_invalidate(bbus_i2c_regmap_t *map)
+{
+    for (uint16_t i = 0; i < map->num; i++)
+    {
+        map->flags[i] &= (uint8_t)~(BBUS_I2C_REGMAP_VALID | BBUS_I2C_REGMAP_DIRTY);
+    }
+}
+
+/**
+ * @brief       读寄存器，缓存有效时不访问总线
+ * @param       map: 寄存器缓存
+ * @param       reg_address: 寄存器地址
+ * @param       val: 读取的值
+ * @param       timeout: 超时时间ms
+ * @retval      0，读取成功；1，读取失败
+ */
+uint8_t bbus_i2c_regmap_read(bbus_i2c_regmap_t *map, uint16_t reg_address, uint8_t *val, uint32_t timeout)
+{
+    return bbus_i2c_regmap_bulk_read(map, reg_address, val, 1, timeout);
+}
+
+/**
+ * @brief       连续读多个寄存器，区间内全部缓存可用时不访问总线，否则整段一次读取并更新缓存
+ * @param       map: 寄存器缓存
+ * @param       reg_address: 第一个寄存器地址
+ * @param       data: 存储读取数据的缓冲区
+ * @param       len: 要读取的寄存器数量
+ * @param       timeout: 超时时间ms
+ * @retval      0，读取成功；1，读取失败
+ */
+uint8_t bbus_i2c_regmap_bulk_read(bbus_i2c_regmap_t *map, uint16_t reg_address, uint8_t *data, uint8_t len, uint32_t timeout)
+{
+    uint32_t now = bbus_i2c_regmap_now(map);
+    uint8_t n;
+
+    for (n = 0; n < len; n++)
+    {
+        if (!bbus_i2c_regmap_cached(map, bbus_i2c_regmap_index(map, (uint16_t)(reg_address + n)), now))
+        {
+            break;
+        }
+    }
+    if (n == len)
+    {
+        for (n = 0; n < len; n++)
+        {
+            data[n] = map->cache[bbus_i2c_regmap_index(map, (uint16_t)(reg_address + n))];
+        }
+        map->hits++;
+        map->saved_us += bbus_i2c_regmap_read_cost(map, len);
+        return 0;
+    }
+
+    map->misses++;
+    if (bbus_i2c_dev_read(map->dev, reg_address, data, len, timeout))
+    {
+        return 1;
+    }
+    for (n = 0; n < len; n++)
+    {
+        uint16_t i = bbus_i2c_regmap_index(map, (uint16_t)(reg_address + n));
+
+        if (i < map->num && (map->flags[i] & BBUS_I2C_REGMAP_DIRTY))
+        {
+            data[n] = map->cache[i]; // 尚未写回的修改以缓存为准
+        }
+        else
+        {
+            bbus_i2c_regmap_store(map, i, data[n], now);
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief       写寄存器，写入值与有效缓存相同时省略总线写
+ * @param       map: 寄存器缓存
+ * @param       reg_address: 寄存器地址
+ * @param       val: 要写入的值
+ * @param       timeout: 超时时间ms
+ * @retval      0，写入成功；1，写入失败
+ */
+uint8_t bbus_i2c_regmap_write(bbus_i2c_regmap_t *map, uint16_t reg_address, uint8_t val, uint32_t timeout)
+{
+    uint16_t i = bbus_i2c_regmap_index(map, reg_address);
+    uint32_t now = bbus_i2c_regmap_now(map);
+
+    if (bbus_i2c_regmap_cached(map, i, now) && map->cache[i] == val)
+    {
+        map->hits++;
+        return 0;
+    }
+    if (map->write_back && i < map->num && !(map->flags[i] & (BBUS_I2C_REGMAP_VOLATILE | BBUS_I2C_REGMAP_TTL)))
+    {
+        map->cache[i] = val;
+        map->flags[i] |= BBUS_I2C_REGMAP_VALID | BBUS_I2C_REGMAP_DIRTY;
+        return 0;
+    }
+    map->misses++;
+    if (bbus_i2c_dev_write(map->dev, reg_address, &val, 1, timeout))
+    {
+        if (i < map->num)
+        {
+            map->flags[i] &= (uint8_t)~BBUS_I2C_REGMAP_VALID; // 写入失败，设备中的值不确定
+        }
+        return 1;
+    }
+    bbus_i2c_regmap_store(map, i, val, now);
+    return 0;
+}
+
+/**
+ * @brief       读-改-写寄存器的部分位，缓存有效时只需一次总线写(值不变时无需访问总线)
+ * @note        读和写在同一次总线锁定内完成，其他任务不会插入
+ * @param       map: 寄存器缓存
+ * @param       reg_address: 寄存器地址
+ * @param       mask: 要修改的位
+ * @param       val: 新值(只取 mask 中的位)
+ * @param       timeout: 超时时间ms
+ * @retval      0，成功；1，失败
+ */
+uint8_t bbus_i2c_regmap_update_bits(bbus_i2c_regmap_t *map, uint16_t reg_address, uint8_t mask, uint8_t val, uint32_t timeout)
+{
+    uint8_t old, ret;
+
+    if (bbus_i2c_lock(map->dev->lun, timeout))
+    {
+        return 1; // 获取总线失败
+    }
+    ret = bbus_i2c_regmap_read(map, reg_address, &old, timeout);
+    if (ret == 0)
+    {
+        ret = bbus_i2c_regmap_write(map, reg_address, (uint8_t)((old & ~mask) | (val & mask)), timeout);
+    }
+    bbus_i2c_unlock(map->dev->lun);
+
+    return ret;
+}
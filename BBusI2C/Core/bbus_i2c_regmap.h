@@ -0,0 +1,169 @@
+/**
+ * @file    bbus_i2c_regmap.h
+ * @version v1.0
+ * @date    2026-10-19
+ * @author  ZeroOneLab
+ * @website https://github.com/ZeroOneLab/BBusI2C.git
+ *
+ * @license MIT License
+ * Copyright (c) 2026 ZeroOneLab
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BBUS_I2C_REGMAP_H
+#define BBUS_I2C_REGMAP_H
+
+#include "bbus_i2c_dev.h"
+
+/* 寄存器标志，flags 数组每个寄存器一个字节 */
+#define BBUS_I2C_REGMAP_VALID    (1u << 0) // 缓存值有效
+#define BBUS_I2C_REGMAP_VOLATILE (1u << 1) // 易失寄存器(状态/数据等)，读写始终访问总线
+#define BBUS_I2C_REGMAP_DIRTY    (1u << 2) // 写回模式下已修改、尚未写入设备
+#define BBUS_I2C_REGMAP_TTL      (1u << 3) // 限时缓存：缓存值在 ttl 时间内有效(ID、状态、校准等变化缓慢的寄存器)
+
+/* 寄存器影子缓存：缓存区间 [base, base + num) 内寄存器的值，
+ * 写入值与缓存相同时省略总线写，读取命中时直接返回缓存 */
+typedef struct
+{
+    bbus_i2c_dev_t *dev; /* 设备描述 */
+    uint16_t base;       /* 第一个缓存寄存器的地址 */
+    uint16_t num;        /* 缓存寄存器数量 */
+    uint8_t *cache;      /* 寄存器值缓存，num 字节 */
+    uint8_t *flags;      /* 寄存器标志 BBUS_I2C_REGMAP_xxx，num 字节 */
+    uint8_t write_back;  /* 1：写回模式，写入只修改缓存，由 bbus_i2c_regmap_flush 统一写入设备 */
+    uint8_t max_burst;   /* 写回时单次连续写的最大字节数 */
+    uint32_t ttl;        /* 限时缓存的有效时间(ms) */
+    uint32_t *stamp;     /* 限时缓存寄存器的缓存时刻，num 个元素，不使用限时缓存时为NULL */
+    uint32_t hits;       /* 缓存命中次数(读命中或省略的写) */
+    uint32_t misses;     /* 缓存未命中次数 */
+    uint32_t saved_us;   /* 读命中节省的总线时间估算(us) */
+} bbus_i2c_regmap_t;
+
+/**
+ * @brief       初始化寄存器影子缓存，所有寄存器初始为无效、非易失
+ * @param       map: 寄存器缓存
+ * @param       dev: 设备描述
+ * @param       base: 第一个缓存寄存器的地址
+ * @param       num: 缓存寄存器数量
+ * @param       cache: 寄存器值缓存，num 字节
+ * @param       flags: 寄存器标志，num 字节
+ * @retval      无
+ */
+void bbus_i2c_regmap_init(bbus_i2c_regmap_t *map, bbus_i2c_dev_t *dev, uint16_t base, uint16_t num, uint8_t *cache, uint8_t *flags);
+
+/**
+ * @brief       标记寄存器为易失/非易失
+ * @param       map: 寄存器缓存
+ * @param       reg_address: 寄存器地址
+ * @param       is_volatile: 1：易失，始终访问总线；0：非易失，可使用缓存
+ * @retval      无
+ */
+void bbus_i2c_regmap_set_volatile(bbus_i2c_regmap_t *map, uint16_t reg_address, uint8_t is_volatile);
+
+/**
+ * @brief       配置限时缓存
+ * @param       map: 寄存器缓存
+ * @param       ttl: 缓存有效时间(ms)，基于 bbus_i2c_port_tick_get
+ * @param       stamp: 各寄存器的缓存时刻，num 个元素
+ * @retval      无
+ */
+void bbus_i2c_regmap_set_ttl(bbus_i2c_regmap_t *map, uint32_t ttl, uint32_t *stamp);
+
+/**
+ * @brief       标记寄存器为限时缓存
+ * @note        需先调用 bbus_i2c_regmap_set_ttl；限时缓存寄存器在写回模式下仍直接写入设备
+ * @param       map: 寄存器缓存
+ * @param       reg_address: 寄存器地址
+ * @param       enable: 1：缓存值仅在 ttl 内有效；0：普通缓存
+ * @retval      无
+ */
+void bbus_i2c_regmap_set_reg_ttl(bbus_i2c_regmap_t *map, uint16_t reg_address, uint8_t enable);
+
+/**
+ * @brief       设置写回模式
+ * @note        关闭写回模式前应先调用 bbus_i2c_regmap_flush，否则未写入的修改会保留到下次 flush
+ * @param       map: 寄存器缓存
+ * @param       enable: 1：写回模式；0：写直达模式
+ * @param       max_burst: 单次连续写的最大字节数(设备页大小等)，0 表示不限制
+ * @retval      无
+ */
+void bbus_i2c_regmap_set_write_back(bbus_i2c_regmap_t *map, uint8_t enable, uint8_t max_burst);
+
+/**
+ * @brief       把写回模式下已修改的寄存器写入设备
+ * @note        地址连续的已修改寄存器合并为一次自动递增的连续写，每次不超过 max_burst 字节
+ * @param       map: 寄存器缓存
+ * @param       timeout: 超时时间ms
+ * @retval      0，全部写入成功；1，写入失败(未写入的寄存器保持已修改状态)
+ */
+uint8_t bbus_i2c_regmap_flush(bbus_i2c_regmap_t *map, uint32_t timeout);
+
+/**
+ * @brief       使全部缓存失效，设备复位后调用
+ * @note        尚未写回的修改一并丢弃
+ * @param       map: 寄存器缓存
+ * @retval      无
+ */
+void bbus_i2c_regmap_invalidate(bbus_i2c_regmap_t *map);
+
+/**
+ * @brief       读寄存器，缓存有效时不访问总线
+ * @param       map: 寄存器缓存
+ * @param       reg_address: 寄存器地址
+ * @param       val: 读取的值
+ * @param       timeout: 超时时间ms
+ * @retval      0，读取成功；1，读取失败
+ */
+uint8_t bbus_i2c_regmap_read(bbus_i2c_regmap_t *map, uint16_t reg_address, uint8_t *val, uint32_t timeout);
+
+/**
+ * @brief       连续读多个寄存器，区间内全部缓存可用时不访问总线，否则整段一次读取并更新缓存
+ * @param       map: 寄存器缓存
+ * @param       reg_address: 第一个寄存器地址
+ * @param       data: 存储读取数据的缓冲区
+ * @param       len: 要读取的寄存器数量
+ * @param       timeout: 超时时间ms
+ * @retval      0，读取成功；1，读取失败
+ */
+uint8_t bbus_i2c_regmap_bulk_read(bbus_i2c_regmap_t *map, uint16_t reg_address, uint8_t *data, uint8_t len, uint32_t timeout);
+
+/**
+ * @brief       写寄存器，写入值与有效缓存相同时省略总线写
+ * @note        写回模式下只修改缓存并标记为已修改，易失寄存器始终直接写入设备
+ * @param       map: 寄存器缓存
+ * @param       reg_address: 寄存器地址
+ * @param       val: 要写入的值
+ * @param       timeout: 超时时间ms
+ * @retval      0，写入成功；1，写入失败
+ */
+uint8_t bbus_i2c_regmap_write(bbus_i2c_regmap_t *map, uint16_t reg_address, uint8_t val, uint32_t timeout);
+
+/**
+ * @brief       读-改-写寄存器的部分位，缓存有效时只需一次总线写(值不变时无需访问总线)
+ * @param       map: 寄存器缓存
+ * @param       reg_address: 寄存器地址
+ * @param       mask: 要修改的位
+ * @param       val: 新值(只取 mask 中的位)
+ * @param       timeout: 超时时间ms
+ * @retval      0，成功；1，失败
+ */
+uint8_t bbus_i2c_regmap_update_bits(bbus_i2c_regmap_t *map, uint16_t reg_address, uint8_t mask, uint8_t val, uint32_t timeout);
+
+#endif
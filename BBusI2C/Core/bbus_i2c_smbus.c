@@ -0,0 +1,474 @@
+/**
+ * @file    bbus_i2c_smbus.c
+ * @version v1.0
+ * @date    2026-10-19
+ * @author  ZeroOneLab
+ * @website https://github.com/ZeroOneLab/BBusI2C.git
+ *
+ * @license MIT License
+ * Copyright (c) 2026 ZeroOneLab
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "bbus_i2c_smbus.h"
+
+/* CRC-8 查找表，多项式 0x07：每字节一次查表与一次异或，PEC随字节收发同步累加，无需对缓冲区再做一遍计算 */
+static const uint8_t pec_table[256] = {
+    0x00, 0x07, 0x0E, 0x09, 0x1C, 0x1B, 0x12, 0x15, 0x38, 0x3F, 0x36, 0x31, 0x24, 0x23, 0x2A, 0x2D,
+    0x70, 0x77, 0x7E, 0x79, 0x6C, 0x6B, 0x62, 0x65, 0x48, 0x4F, 0x46, 0x41, 0x54, 0x53, 0x5A, 0x5D,
+    0xE0, 0xE7, 0xEE, 0xE9, 0xFC, 0xFB, 0xF2, 0xF5, 0xD8, 0xDF, 0xD6, 0xD1, 0xC4, 0xC3, 0xCA, 0xCD,
+    0x90, 0x97, 0x9E, 0x99, 0x8C, 0x8B, 0x82, 0x85, 0xA8, 0xAF, 0xA6, 0xA1, 0xB4, 0xB3, 0xBA, 0xBD,
+    0xC7, 0xC0, 0xC9, 0xCE, 0xDB, 0xDC, 0xD5, 0xD2, 0xFF, 0xF8, 0xF1, 0xF6, 0xE3, 0xE4, 0xED, 0xEA,
+    0xB7, 0xB0, 0xB9, 0xBE, 0xAB, 0xAC, 0xA5, 0xA2, 0x8F, 0x88, 0x81, 0x86, 0x93, 0x94, 0x9D, 0x9A,
+    0x27, 0x20, 0x29, 0x2E, 0x3B, 0x3C, 0x35, 0x32, 0x1F, 0x18, 0x11, 0x16, 0x03, 0x04, 0x0D, 0x0A,
+    0x57, 0x50, 0x59, 0x5E, 0x4B, 0x4C, 0x45, 0x42, 0x6F, 0x68, 0x61, 0x66, 0x73, 0x74, 0x7D, 0x7A,
+    0x89, 0x8E, 0x87, 0x80, 0x95, 0x92, 0x9B, 0x9C, 0xB1, 0xB6, 0xBF, 0xB8, 0xAD, 0xAA, 0xA3, 0xA4,
+    0xF9, 0xFE, 0xF7, 0xF0, 0xE5, 0xE2, 0xEB, 0xEC, 0xC1, 0xC6, 0xCF, 0xC8, 0xDD, 0xDA, 0xD3, 0xD4,
+    0x69, 0x6E, 0x67, 0x60, 0x75, 0x72, 0x7B, 0x7C, 0x51, 0x56, 0x5F, 0x58, 0x4D, 0x4A, 0x43, 0x44,
+    0x19, 0x1E, 0x17, 0x10, 0x05, 0x02, 0x0B, 0x0C, 0x21, 0x26, 0x2F, 0x28, 0x3D, 0x3A, 0x33, 0x34,
+    0x4E, 0x49, 0x40, 0x47, 0x52, 0x55, 0x5C, 0x5B, 0x76, 0x71, 0x78, 0x7F, 0x6A, 0x6D, 0x64, 0x63,
+    0x3E, 0x39, 0x30, 0x37, 0x22, 0x25, 0x2C, 0x2B, 0x06, 0x01, 0x08, 0x0F, 0x1A, 0x1D, 0x14, 0x13,
+    0xAE, 0xA9, 0xA0, 0xA7, 0xB2, 0xB5, 0xBC, 0xBB, 0x96, 0x91, 0x98, 0x9F, 0x8A, 0x8D, 0x84, 0x83,
+    0xDE, 0xD9, 0xD0, 0xD7, 0xC2, 0xC5, 0xCC, 0xCB, 0xE6, 0xE1, 0xE8, 0xEF, 0xFA, 0xFD, 0xF4, 0xF3,
+};
+
+static uint8_t pec_enable[BBUS_I2C_BUS_NUM];
+static uint8_t smbus_error[BBUS_I2C_BUS_NUM];
+
+#define PEC_UPDATE(pec, byte) ((pec) = pec_table[(uint8_t)((pec) ^ (byte))])
+
+/* 一次SMBus传输：写阶段(地址(写) + wr[]) 与可选的读阶段(重复起始 + 地址(读) + 读取)，
+ * 经核心层字节级事务(bbus_i2c_xfer_xxx)收发，共用互斥锁、关中断粒度、时钟延展检测与错误码 */
+typedef struct
+{
+    uint8_t lun;
+    uint8_t slave_addr;
+    uint8_t pec; /* 累加中的PEC */
+    uint32_t timeout;
+} bbus_i2c_smbus_xfer_t;
+
+/**
+ * @brief       发送一个字节并等待应答，同时累加PEC
+ * @param       x: 传输
+ * @param       data: 要发送的字节
+ * @retval      0，应答；1，未应答
+ */
+static uint8_t bbus_i2c_smbus_tx(bbus_i2c_smbus_xfer_t *x, uint8_t data)
+{
+    PEC_UPDATE(x->pec, data);
+    if (bbus_i2c_xfer_tx(x->lun, data, x->timeout))
+    {
+        smbus_error[x->lun] = BBUS_I2C_SMBUS_ERR_BUS;
+        BBUS_I2C_LOG("[I2C SMBus][ERROR]: Wait ACK failed for address 0x%02X\n", x->slave_addr);
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief       接收一个字节，同时累加PEC
+ * @param       x: 传输
+ * @param       ack: ack=1时，发送ack; ack=0时，发送nack
+ * @retval      接收到的字节
+ */
+static uint8_t bbus_i2c_smbus_rx(bbus_i2c_smbus_xfer_t *x, uint8_t ack)
+{
+    uint8_t data = bbus_i2c_xfer_rx(x->lun, ack);
+
+    PEC_UPDATE(x->pec, data);
+    return data;
+}
+
+/**
+ * @brief       获取总线并发送起始信号与地址(写)
+ * @param       x: 传输
+ * @param       lun: I2C总线号
+ * @param       slave_addr: 从设备地址
+ * @param       rw: 读写位
+ * @param       timeout: 超时时间ms
+ * @retval      0，成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时(不更新错误码)；1，失败(总线已释放)
+ */
+static uint8_t bbus_i2c_smbus_begin(bbus_i2c_smbus_xfer_t *x, uint8_t lun, uint8_t slave_addr, uint8_t rw, uint32_t timeout)
+{
+    uint8_t ret;
+
+    x->lun = lun;
+    x->slave_addr = slave_addr;
+    x->pec = 0;
+    x->timeout = timeout;
+    ret = bbus_i2c_xfer_open(lun, timeout);
+    if (ret)
+    {
+        return ret; // 获取总线失败：总线归其他任务所有，不改写错误码
+    }
+    smbus_error[lun] = BBUS_I2C_SMBUS_ERR_NONE;
+    bbus_i2c_xfer_start(lun);
+    if (bbus_i2c_smbus_tx(x, (uint8_t)((slave_addr & 0xFE) | rw)))
+    {
+        bbus_i2c_xfer_close(lun);
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief       结束传输：产生停止信号并释放总线，核心层记录的错误(时钟延展超时等)记为 BBUS_I2C_SMBUS_ERR_BUS
+ * @param       x: 传输
+ * @param       ret: 传输结果
+ * @retval      传输结果
+ */
+static uint8_t bbus_i2c_smbus_end(bbus_i2c_smbus_xfer_t *x, uint8_t ret)
+{
+    if (bbus_i2c_xfer_close(x->lun))
+    {
+        if (smbus_error[x->lun] == BBUS_I2C_SMBUS_ERR_NONE || bbus_i2c_get_error(x->lun) == BBUS_I2C_ERR_STRETCH_TIMEOUT)
+        {
+            smbus_error[x->lun] = BBUS_I2C_SMBUS_ERR_BUS; // 总线错误使读到的数据与PEC结果无效
+        }
+        if (!ret)
+        {
+            BBUS_I2C_LOG("[I2C SMBus][ERROR]: Bus error %d for address 0x%02X\n", bbus_i2c_get_error(x->lun), x->slave_addr);
+        }
+        ret = 1;
+    }
+    return ret;
+}
+
+/**
+ * @brief       写传输：地址(写) + buf[] [+ PEC]
+ * @param       lun: I2C总线号
+ * @param       slave_addr: 从设备地址
+ * @param       buf: 命令码、字节数与数据
+ * @param       len: 长度
+ * @param       timeout: 超时时间ms
+ * @retval      0，成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，失败
+ */
+static uint8_t bbus_i2c_smbus_write(uint8_t lun, uint8_t slave_addr, const uint8_t *buf, uint8_t len, uint32_t timeout)
+{
+    bbus_i2c_smbus_xfer_t x;
+    uint8_t ret;
+
+    ret = bbus_i2c_smbus_begin(&x, lun, slave_addr, 0, timeout);
+    if (ret)
+    {
+        return ret;
+    }
+    for (uint8_t i = 0; i < len && ret == 0; i++)
+    {
+        ret = bbus_i2c_smbus_tx(&x, buf[i]);
+    }
+    if (ret == 0 && pec_enable[lun])
+    {
+        ret = bbus_i2c_smbus_tx(&x, x.pec);
+    }
+    return bbus_i2c_smbus_end(&x, ret);
+}
+
+/**
+ * @brief       读传输：[地址(写) + wr[] + 重复起始] + 地址(读) + 数据 [+ PEC]
+ * @param       lun: I2C总线号
+ * @param       slave_addr: 从设备地址
+ * @param       wr: 命令码等写入数据，wr_len 为0时直接读取
+ * @param       wr_len: 写入长度
+ * @param       rd: 存储读取数据的缓冲区
+ * @param       rd_len: 读取长度；块读取时为缓冲区大小
+ * @param       block: 1：块读取，第一个字节为字节数
+ * @param       count: 块读取时返回实际字节数，可为NULL
+ * @param       timeout: 超时时间ms
+ * @retval      0，成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，失败
+ */
+static uint8_t bbus_i2c_smbus_read(uint8_t lun, uint8_t slave_addr, const uint8_t *wr, uint8_t wr_len,
+                                   uint8_t *rd, uint8_t rd_len, uint8_t block, uint8_t *count, uint32_t timeout)
+{
+    bbus_i2c_smbus_xfer_t x;
+    uint8_t use_pec = pec_enable[lun];
+    uint8_t ret, n = rd_len;
+
+    ret = bbus_i2c_smbus_begin(&x, lun, slave_addr, wr_len ? 0 : 1, timeout);
+    if (ret)
+    {
+        return ret;
+    }
+    if (wr_len)
+    {
+        for (uint8_t i = 0; i < wr_len && ret == 0; i++)
+        {
+            ret = bbus_i2c_smbus_tx(&x, wr[i]);
+        }
+        if (ret == 0)
+        {
+            bbus_i2c_xfer_start(lun);
+            ret = bbus_i2c_smbus_tx(&x, slave_addr | 0x01);
+        }
+    }
+    if (ret == 0 && block)
+    {
+        n = bbus_i2c_smbus_rx(&x, 1);
+        if (n == 0 || n > rd_len)
+        {
+            BBUS_I2C_LOG("[I2C SMBus][ERROR]: Block length %d invalid for address 0x%02X\n", n, slave_addr);
+            bbus_i2c_xfer_rx(lun, 0); // 以NACK结束读取
+            smbus_error[lun] = BBUS_I2C_SMBUS_ERR_LEN;
+            ret = 1;
+        }
+    }
+    if (ret == 0)
+    {
+        for (uint8_t i = 0; i < n; i++)
+        {
+            rd[i] = bbus_i2c_smbus_rx(&x, (uint8_t)(i < n - 1 || use_pec));
+        }
+        if (use_pec)
+        {
+            bbus_i2c_smbus_rx(&x, 0); // PEC字节参与累加后结果为0表示校验正确
+        }
+        if (use_pec && x.pec != 0)
+        {
+            BBUS_I2C_LOG("[I2C SMBus][ERROR]: PEC mismatch for address 0x%02X\n", slave_addr);
+            smbus_error[lun] = BBUS_I2C_SMBUS_ERR_PEC;
+            ret = 1;
+        }
+        if (count)
+        {
+            *count = n;
+        }
+    }
+    return bbus_i2c_smbus_end(&x, ret);
+}
+
+/**
+ * @brief       开启/关闭总线的包错误校验(PEC)
+ * @param       lun: I2C总线号
+ * @param       enable: 1：开启，写操作追加PEC字节，读操作校验PEC字节；0：关闭
+ * @retval      无
+ */
+void bbus_i2c_smbus_set_pec(uint8_t lun, uint8_t enable)
+{
+    pec_enable[lun] = enable;
+}
+
+/**
+ * @brief       获取最近一次SMBus传输的错误码
+ * @param       lun: I2C总线号
+ * @retval      BBUS_I2C_SMBUS_ERR_xxx
+ */
+uint8_t bbus_i2c_smbus_get_error(uint8_t lun)
+{
+    return smbus_error[lun];
+}
+
+/**
+ * @brief       计算PEC(CRC-8，多项式 x^8+x^2+x+1)，查表实现，可分段累加
+ * @param       pec: 前一段的PEC，首段为0
+ * @param       data: 数据
+ * @param       len: 数据长度
+ * @retval      累加后的PEC
+ */
+uint8_t bbus_i2c_smbus_pec(uint8_t pec, const uint8_t *data, uint8_t len)
+{
+    for (uint8_t i = 0; i < len; i++)
+    {
+        PEC_UPDATE(pec, data[i]);
+    }
+    return pec;
+}
+
+/**
+ * @brief       Quick Command：只发送地址与读写位
+ * @param       lun: I2C总线号
+ * @param       slave_addr: 从设备地址
+ * @param       rw: 读写位，0：写；1：读
+ * @param       timeout: 超时时间ms
+ * @retval      0，成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，失败
+ */
+uint8_t bbus_i2c_smbus_quick(uint8_t lun, uint8_t slave_addr, uint8_t rw, uint32_t timeout)
+{
+    bbus_i2c_smbus_xfer_t x;
+    uint8_t ret;
+
+    ret = bbus_i2c_smbus_begin(&x, lun, slave_addr, rw ? 1 : 0, timeout);
+    if (ret)
+    {
+        return ret;
+    }
+    return bbus_i2c_smbus_end(&x, 0);
+}
+
+/**
+ * @brief       Send Byte
+ * @param       lun: I2C总线号
+ * @param       slave_addr: 从设备地址
+ * @param       data: 要发送的字节
+ * @param       timeout: 超时时间ms
+ * @retval      0，成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，失败
+ */
+uint8_t bbus_i2c_smbus_send_byte(uint8_t lun, uint8_t slave_addr, uint8_t data, uint32_t timeout)
+{
+    return bbus_i2c_smbus_write(lun, slave_addr, &data, 1, timeout);
+}
+
+/**
+ * @brief       Receive Byte
+ * @param       lun: I2C总线号
+ * @param       slave_addr: 从设备地址
+ * @param       data: 接收的字节
+ * @param       timeout: 超时时间ms
+ * @retval      0，成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，失败
+ */
+uint8_t bbus_i2c_smbus_receive_byte(uint8_t lun, uint8_t slave_addr, uint8_t *data, uint32_t timeout)
+{
+    return bbus_i2c_smbus_read(lun, slave_addr, 0, 0, data, 1, 0, 0, timeout);
+}
+
+/**
+ * @brief       Write Byte
+ * @param       lun: I2C总线号
+ * @param       slave_addr: 从设备地址
+ * @param       command: 命令码
+ * @param       data: 要写入的字节
+ * @param       timeout: 超时时间ms
+ * @retval      0，成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，失败
+ */
+uint8_t bbus_i2c_smbus_write_byte(uint8_t lun, uint8_t slave_addr, uint8_t command, uint8_t data, uint32_t timeout)
+{
+    const uint8_t buf[2] = {command, data};
+
+    return bbus_i2c_smbus_write(lun, slave_addr, buf, 2, timeout);
+}
+
+/**
+ * @brief       Read Byte
+ * @param       lun: I2C总线号
+ * @param       slave_addr: 从设备地址
+ * @param       command: 命令码
+ * @param       data: 读取的字节
+ * @param       timeout: 超时时间ms
+ * @retval      0，成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，失败
+ */
+uint8_t bbus_i2c_smbus_read_byte(uint8_t lun, uint8_t slave_addr, uint8_t command, uint8_t *data, uint32_t timeout)
+{
+    return bbus_i2c_smbus_read(lun, slave_addr, &command, 1, data, 1, 0, 0, timeout);
+}
+
+/**
+ * @brief       Write Word(低字节在前)
+ * @param       lun: I2C总线号
+ * @param       slave_addr: 从设备地址
+ * @param       command: 命令码
+ * @param       data: 要写入的字
+ * @param       timeout: 超时时间ms
+ * @retval      0，成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，失败
+ */
+uint8_t bbus_i2c_smbus_write_word(uint8_t lun, uint8_t slave_addr, uint8_t command, uint16_t data, uint32_t timeout)
+{
+    const uint8_t buf[3] = {command, (uint8_t)data, (uint8_t)(data >> 8)};
+
+    return bbus_i2c_smbus_write(lun, slave_addr, buf, 3, timeout);
+}
+
+/**
+ * @brief       Read Word(低字节在前)
+ * @param       lun: I2C总线号
+ * @param       slave_addr: 从设备地址
+ * @param       command: 命令码
+ * @param       data: 读取的字
+ * @param       timeout: 超时时间ms
+ * @retval      0，成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，失败
+ */
+uint8_t bbus_i2c_smbus_read_word(uint8_t lun, uint8_t slave_addr, uint8_t command, uint16_t *data, uint32_t timeout)
+{
+    uint8_t buf[2], ret;
+
+    ret = bbus_i2c_smbus_read(lun, slave_addr, &command, 1, buf, 2, 0, 0, timeout);
+    if (ret)
+    {
+        return ret;
+    }
+    *data = (uint16_t)(buf[0] | (buf[1] << 8));
+    return 0;
+}
+
+/**
+ * @brief       Process Call：写入一个字后读回一个字
+ * @param       lun: I2C总线号
+ * @param       slave_addr: 从设备地址
+ * @param       command: 命令码
+ * @param       data: 要写入的字
+ * @param       result: 读回的字
+ * @param       timeout: 超时时间ms
+ * @retval      0，成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，失败
+ */
+uint8_t bbus_i2c_smbus_process_call(uint8_t lun, uint8_t slave_addr, uint8_t command, uint16_t data, uint16_t *result, uint32_t timeout)
+{
+    const uint8_t wr[3] = {command, (uint8_t)data, (uint8_t)(data >> 8)};
+    uint8_t buf[2], ret;
+
+    ret = bbus_i2c_smbus_read(lun, slave_addr, wr, 3, buf, 2, 0, 0, timeout);
+    if (ret)
+    {
+        return ret;
+    }
+    *result = (uint16_t)(buf[0] | (buf[1] << 8));
+    return 0;
+}
+
+/**
+ * @brief       Block Write：命令码 + 字节数 + 数据
+ * @param       lun: I2C总线号
+ * @param       slave_addr: 从设备地址
+ * @param       command: 命令码
+ * @param       data: 要写入的数据
+ * @param       len: 数据长度，1~BBUS_I2C_SMBUS_BLOCK_MAX
+ * @param       timeout: 超时时间ms
+ * @retval      0，成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，失败
+ */
+uint8_t bbus_i2c_smbus_block_write(uint8_t lun, uint8_t slave_addr, uint8_t command, const uint8_t *data, uint8_t len, uint32_t timeout)
+{
+    uint8_t buf[BBUS_I2C_SMBUS_BLOCK_MAX + 2];
+
+    if (len == 0 || len > BBUS_I2C_SMBUS_BLOCK_MAX)
+    {
+        smbus_error[lun] = BBUS_I2C_SMBUS_ERR_LEN;
+        return 1;
+    }
+    buf[0] = command;
+    buf[1] = len;
+    for (uint8_t i = 0; i < len; i++)
+    {
+        buf[2 + i] = data[i];
+    }
+    return bbus_i2c_smbus_write(lun, slave_addr, buf, (uint8_t)(len + 2), timeout);
+}
+
+/**
+ * @brief       Block Read：读取字节数前缀与数据
+ * @param       lun: I2C总线号
+ * @param       slave_addr: 从设备地址
+ * @param       command: 命令码
+ * @param       data: 存储读取数据的缓冲区
+ * @param       size: 缓冲区大小
+ * @param       len: 返回实际读取的字节数
+ * @param       timeout: 超时时间ms
+ * @retval      0，成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，失败
+ */
+uint8_t bbus_i2c_smbus_block_read(uint8_t lun, uint8_t slave_addr, uint8_t command, uint8_t *data, uint8_t size, uint8_t *len, uint32_t timeout)
+{
+    return bbus_i2c_smbus_read(lun, slave_addr, &command, 1, data, size, 1, len, timeout);
+}
@@ -0,0 +1,178 @@
+/**
+ * @file    bbus_i2c_smbus.h
+ * @version v1.0
+ * @date    2026-10-19
+ * @author  ZeroOneLab
+ * @website https://github.com/ZeroOneLab/BBusI2C.git
+ *
+ * @license MIT License
+ * Copyright (c) 2026 ZeroOneLab
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BBUS_I2C_SMBUS_H
+#define BBUS_I2C_SMBUS_H
+
+#include "bbus_i2c.h"
+
+#define BBUS_I2C_SMBUS_BLOCK_MAX 32 // SMBus 2.0 块传输最大字节数
+
+/* 错误码，由 bbus_i2c_smbus_get_error 返回 */
+#define BBUS_I2C_SMBUS_ERR_NONE 0 // 无错误
+#define BBUS_I2C_SMBUS_ERR_BUS  1 // 总线错误(未应答、时钟延展超时等)，详见 bbus_i2c_get_error；获取总线超时只体现在返回值中
+#define BBUS_I2C_SMBUS_ERR_PEC  2 // PEC校验错误
+#define BBUS_I2C_SMBUS_ERR_LEN  3 // 块读取长度为0或超过缓冲区
+
+/**
+ * @brief       开启/关闭总线的包错误校验(PEC)
+ * @param       lun: I2C总线号
+ * @param       enable: 1：开启，写操作追加PEC字节，读操作校验PEC字节；0：关闭
+ * @retval      无
+ */
+void bbus_i2c_smbus_set_pec(uint8_t lun, uint8_t enable);
+
+/**
+ * @brief       获取最近一次SMBus传输的错误码
+ * @param       lun: I2C总线号
+ * @retval      BBUS_I2C_SMBUS_ERR_xxx
+ */
+uint8_t bbus_i2c_smbus_get_error(uint8_t lun);
+
+/**
+ * @brief       计算PEC(CRC-8，多项式 x^8+x^2+x+1)，查表实现，可分段累加
+ * @param       pec: 前一段的PEC，首段为0
+ * @param       data: 数据
+ * @param       len: 数据长度
+ * @retval      累加后的PEC
+ */
+uint8_t bbus_i2c_smbus_pec(uint8_t pec, const uint8_t *data, uint8_t len);
+
+/**
+ * @brief       Quick Command：只发送地址与读写位
+ * @param       lun: I2C总线号
+ * @param       slave_addr: 从设备地址
+ * @param       rw: 读写位，0：写；1：读
+ * @param       timeout: 超时时间ms
+ * @retval      0，成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，失败
+ */
+uint8_t bbus_i2c_smbus_quick(uint8_t lun, uint8_t slave_addr, uint8_t rw, uint32_t timeout);
+
+/**
+ * @brief       Send Byte
+ * @param       lun: I2C总线号
+ * @param       slave_addr: 从设备地址
+ * @param       data: 要发送的字节
+ * @param       timeout: 超时时间ms
+ * @retval      0，成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，失败
+ */
+uint8_t bbus_i2c_smbus_send_byte(uint8_t lun, uint8_t slave_addr, uint8_t data, uint32_t timeout);
+
+/**
+ * @brief       Receive Byte
+ * @param       lun: I2C总线号
+ * @param       slave_addr: 从设备地址
+ * @param       data: 接收的字节
+ * @param       timeout: 超时时间ms
+ * @retval      0，成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，失败
+ */
+uint8_t bbus_i2c_smbus_receive_byte(uint8_t lun, uint8_t slave_addr, uint8_t *data, uint32_t timeout);
+
+/**
+ * @brief       Write Byte
+ * @param       lun: I2C总线号
+ * @param       slave_addr: 从设备地址
+ * @param       command: 命令码
+ * @param       data: 要写入的字节
+ * @param       timeout: 超时时间ms
+ * @retval      0，成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，失败
+ */
+uint8_t bbus_i2c_smbus_write_byte(uint8_t lun, uint8_t slave_addr, uint8_t command, uint8_t data, uint32_t timeout);
+
+/**
+ * @brief       Read Byte
+ * @param       lun: I2C总线号
+ * @param       slave_addr: 从设备地址
+ * @param       command: 命令码
+ * @param       data: 读取的字节
+ * @param       timeout: 超时时间ms
+ * @retval      0，成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，失败
+ */
+uint8_t bbus_i2c_smbus_read_byte(uint8_t lun, uint8_t slave_addr, uint8_t command, uint8_t *data, uint32_t timeout);
+
+/**
+ * @brief       Write Word(低字节在前)
+ * @param       lun: I2C总线号
+ * @param       slave_addr: 从设备地址
+ * @param       command: 命令码
+ * @param       data: 要写入的字
+ * @param       timeout: 超时时间ms
+ * @retval      0，成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，失败
+ */
+uint8_t bbus_i2c_smbus_write_word(uint8_t lun, uint8_t slave_addr, uint8_t command, uint16_t data, uint32_t timeout);
+
+/**
+ * @brief       Read Word(低字节在前)
+ * @param       lun: I2C总线号
+ * @param       slave_addr: 从设备地址
+ * @param       command: 命令码
+ * @param       data: 读取的字
+ * @param       timeout: 超时时间ms
+ * @retval      0，成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，失败
+ */
+uint8_t bbus_i2c_smbus_read_word(uint8_t lun, uint8_t slave_addr, uint8_t command, uint16_t *data, uint32_t timeout);
+
+/**
+ * @brief       Process Call：写入一个字后读回一个字
+ * @param       lun: I2C总线号
+ * @param       slave_addr: 从设备地址
+ * @param       command: 命令码
+ * @param       data: 要写入的字
+ * @param       result: 读回的字
+ * @param       timeout: 超时时间ms
+ * @retval      0，成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，失败
+ */
+uint8_t bbus_i2c_smbus_process_call(uint8_t lun, uint8_t slave_addr, uint8_t command, uint16_t data, uint16_t *result, uint32_t timeout);
+
+/**
+ * @brief       Block Write：命令码 + 字节数 + 数据
+ * @param       lun: I2C总线号
+ * @param       slave_addr: 从设备地址
+ * @param       command: 命令码
+ * @param       data: 要写入的数据
+ * @param       len: 数据长度，1~BBUS_I2C_SMBUS_BLOCK_MAX
+ * @param       timeout: 超时时间ms
+ * @retval      0，成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，失败
+ */
+uint8_t bbus_i2c_smbus_block_write(uint8_t lun, uint8_t slave_addr, uint8_t command, const uint8_t *data, uint8_t len, uint32_t timeout);
+
+/**
+ * @brief       Block Read：读取字节数前缀与数据
+ * @param       lun: I2C总线号
+ * @param       slave_addr: 从设备地址
+ * @param       command: 命令码
+ * @param       data: 存储读取数据的缓冲区
+ * @param       size: 缓冲区大小
+ * @param       len: 返回实际读取的字节数
+ * @param       timeout: 超时时间ms
+ * @retval      0，成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，失败
+ */
+uint8_t bbus_i2c_smbus_block_read(uint8_t lun, uint8_t slave_addr, uint8_t command, uint8_t *data, uint8_t size, uint8_t *len, uint32_t timeout);
+
+#endif
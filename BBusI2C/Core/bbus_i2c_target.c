@@ -0,0 +1,382 @@
+/**
+ * @file    bbus_i2c_target.c
+ * @version v1.0
+ * @date    2026-10-19
+ * @author  ZeroOneLab
+ * @website https://github.com/ZeroOneLab/BBusI2C.git
+ *
+ * @license MIT License
+ * Copyright (c) 2026 ZeroOneLab
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "bbus_i2c_target.h"
+
+/* 引擎状态 */
+enum
+{
+    T_IDLE,     /* 等待起始信号 */
+    T_ADDR,     /* 接收地址字节 */
+    T_ADDR_ACK, /* 地址应答时钟 */
+    T_RX,       /* 接收数据字节(第一个为寄存器地址) */
+    T_RX_ACK,   /* 数据应答时钟 */
+    T_TX,       /* 发送数据字节 */
+    T_TX_ACK,   /* 等待主机应答 */
+    T_WAIT,     /* 地址不匹配或主机不应答，等待起始/停止信号 */
+};
+
+/**
+ * @brief       驱动SDA：0为拉低，1为释放；非开漏端口通过切换引脚方向释放
+ * @note        线路电平随之变化时记下这是引擎自身产生的边沿，由此触发的SDA中断不再识别起始/停止信号
+ * @param       t: 从机
+ * @param       level: 电平
+ * @retval      无
+ */
+static void target_sda(bbus_i2c_target_t *t, uint8_t level)
+{
+    uint8_t line;
+
+    if (t->sda == level)
+    {
+        return;
+    }
+    line = bbus_i2c_port_sda_get(t->lun);
+    t->sda = level;
+    if (t->od)
+    {
+        bbus_i2c_port_sda_set(t->lun, level);
+    }
+    else if (level == 0)
+    {
+        bbus_i2c_port_sda_set(t->lun, 0);
+        bbus_i2c_port_sda_set_out(t->lun);
+    }
+    else
+    {
+        bbus_i2c_port_sda_set_in(t->lun);
+    }
+    if (line != level && bbus_i2c_port_sda_get(t->lun) == level)
+    {
+        t->edge = 1;
+    }
+}
+
+/**
+ * @brief       字节边界：拉低SCL争取处理时间(时钟延展)
+ * @param       t: 从机
+ * @retval      无
+ */
+static inline void target_hold(bbus_i2c_target_t *t)
+{
+    if (t->stretch)
+    {
+        bbus_i2c_port_scl_set(t->lun, 0);
+    }
+}
+
+static inline void target_release(bbus_i2c_target_t *t)
+{
+    if (t->stretch)
+    {
+        bbus_i2c_port_scl_set(t->lun, 1);
+    }
+}
+
+static uint8_t target_read(bbus_i2c_target_t *t)
+{
+    uint8_t reg = t->reg++;
+
+    t->tx_bytes++;
+    if (t->read_cb)
+    {
+        return t->read_cb(t, reg);
+    }
+    return (t->regs && reg < t->size) ? t->regs[reg] : 0xFF;
+}
+
+static void target_write(bbus_i2c_target_t *t, uint8_t data)
+{
+    uint8_t reg = t->reg++;
+
+    if (t->wr_len++ == 0)
+    {
+        t->wr_reg = reg;
+    }
+    t->rx_bytes++;
+    if (t->write_cb)
+    {
+        t->write_cb(t, reg, data);
+    }
+    else if (t->regs && reg < t->size)
+    {
+        t->regs[reg] = data;
+    }
+}
+
+/**
+ * @brief       结束写事务：有数据写入时调用结束回调
+ * @param       t: 从机
+ * @retval      无
+ */
+static void target_done(bbus_i2c_target_t *t)
+{
+    if (t->wr_len && t->done_cb)
+    {
+        t->done_cb(t, t->wr_reg, t->wr_len);
+    }
+    t->wr_len = 0;
+}
+
+/**
+ * @brief       初始化从机，释放SCL/SDA
+ * @note        端口需支持 BBUS_I2C_PORT_CAP_SCL_READ，SCL/SDA配置为双边沿外部中断，两个中断优先级相同(互不抢占)
+ * @param       t: 从机
+ * @param       lun: 从机使用的引脚(端口层的总线号)
+ * @param       slave_addr: 从机地址(8位形式)
+ * @param       regs: 寄存器文件，可为NULL(此时需设置回调)
+ * @param       size: 寄存器文件大小
+ * @retval      0，成功；1，端口不支持回读SCL
+ */
+uint8_t bbus_i2c_target_init(bbus_i2c_target_t *t, uint8_t lun, uint8_t slave_addr, uint8_t *regs, uint16_t size)
+{
+    uint8_t caps = bbus_i2c_port_get_caps(lun);
+
+    t->lun = lun;
+    t->slave_addr = slave_addr & 0xFE;
+    t->regs = regs;
+    t->size = size;
+    t->read_cb = 0;
+    t->write_cb = 0;
+    t->done_cb = 0;
+    t->user = 0;
+    t->stretch = 1;
+    t->rx_bytes = 0;
+    t->tx_bytes = 0;
+    t->state = T_IDLE;
+    t->od = (caps & BBUS_I2C_PORT_CAP_OPEN_DRAIN) ? 1 : 0;
+    t->sda = 0;
+    t->reg = 0;
+    t->have_reg = 0;
+    t->wr_len = 0;
+    if (!(caps & BBUS_I2C_PORT_CAP_SCL_READ))
+    {
+        BBUS_I2C_LOG("[I2C Target][ERROR]: Bus %d cannot read SCL\n", lun);
+        return 1;
+    }
+    bbus_i2c_port_scl_set(lun, 1);
+    target_sda(t, 1);
+    t->edge = 0;
+    return 0;
+}
+
+/**
+ * @brief       设置寄存器访问回调
+ * @param       t: 从机
+ * @param       read_cb: 读取回调，NULL表示直接读取寄存器文件
+ * @param       write_cb: 写入回调，NULL表示直接写入寄存器文件
+ * @param       done_cb: 写事务结束回调，可为NULL
+ * @param       user: 用户数据
+ * @retval      无
+ */
+void bbus_i2c_target_set_callback(bbus_i2c_target_t *t, bbus_i2c_target_read_cb_t read_cb,
+                                  bbus_i2c_target_write_cb_t write_cb, bbus_i2c_target_done_cb_t done_cb, void *user)
+{
+    t->read_cb = read_cb;
+    t->write_cb = write_cb;
+    t->done_cb = done_cb;
+    t->user = user;
+}
+
+/**
+ * @brief       SCL上升沿：采样主机发送的数据位或应答位
+ * @param       t: 从机
+ * @retval      无
+ */
+static void target_scl_rise(bbus_i2c_target_t *t)
+{
+    uint8_t sda = bbus_i2c_port_sda_get(t->lun);
+
+    switch (t->state)
+    {
+    case T_ADDR:
+    case T_RX:
+        t->sh = (uint8_t)((t->sh << 1) | (sda & 1u));
+        t->bits++;
+        break;
+    case T_TX_ACK:
+        t->bits = sda; // 暂存主机应答位，1表示不应答
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief       SCL下降沿：准备下一个时钟要输出的数据位或应答位
+ * @param       t: 从机
+ * @retval      无
+ */
+static void target_scl_fall(bbus_i2c_target_t *t)
+{
+    uint8_t tx;
+
+    switch (t->state)
+    {
+    case T_ADDR:
+        if (t->bits < 8)
+        {
+            break;
+        }
+        if ((t->sh & 0xFE) != t->slave_addr)
+        {
+            t->state = T_WAIT; // 不是本机地址，不应答
+            break;
+        }
+        target_sda(t, 0);
+        t->state = T_ADDR_ACK;
+        break;
+    case T_ADDR_ACK:
+        if (t->sh & 0x01)
+        {
+            target_hold(t);
+            tx = target_read(t);
+            t->sh = tx;
+            target_sda(t, (tx >> 7) & 1u);
+            t->bits = 1;
+            t->state = T_TX;
+            target_release(t);
+        }
+        else
+        {
+            target_sda(t, 1);
+            t->have_reg = 0; // 写操作的第一个字节为寄存器地址
+            t->bits = 0;
+            t->sh = 0;
+            t->state = T_RX;
+        }
+        break;
+    case T_RX:
+        if (t->bits < 8)
+        {
+            break;
+        }
+        target_hold(t);
+        if (!t->have_reg)
+        {
+            t->reg = t->sh;
+            t->have_reg = 1;
+        }
+        else
+        {
+            target_write(t, t->sh);
+        }
+        target_sda(t, 0);
+        t->state = T_RX_ACK;
+        target_release(t);
+        break;
+    case T_RX_ACK:
+        target_sda(t, 1);
+        t->bits = 0;
+        t->sh = 0;
+        t->state = T_RX;
+        break;
+    case T_TX:
+        if (t->bits < 8)
+        {
+            target_sda(t, (t->sh >> (7 - t->bits)) & 1u);
+            t->bits++;
+        }
+        else
+        {
+            target_sda(t, 1); // 释放SDA，由主机应答
+            t->state = T_TX_ACK;
+        }
+        break;
+    case T_TX_ACK:
+        if (t->bits)
+        {
+            t->state = T_WAIT; // 主机不应答，读取结束
+            break;
+        }
+        target_hold(t);
+        tx = target_read(t);
+        t->sh = tx;
+        target_sda(t, (tx >> 7) & 1u);
+        t->bits = 1;
+        t->state = T_TX;
+        target_release(t);
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief       SCL边沿中断处理，在SCL引脚的双边沿外部中断服务函数中调用
+ * @param       t: 从机
+ * @retval      无
+ */
+void bbus_i2c_target_scl_isr(bbus_i2c_target_t *t)
+{
+    if (t->state == T_IDLE || t->state == T_WAIT)
+    {
+        return;
+    }
+    if (bbus_i2c_port_scl_get(t->lun))
+    {
+        target_scl_rise(t);
+    }
+    else
+    {
+        target_scl_fall(t);
+    }
+}
+
+/**
+ * @brief       SDA边沿中断处理，在SDA引脚的双边沿外部中断服务函数中调用；SCL为高时检测起始/停止信号
+ * @param       t: 从机
+ * @retval      无
+ */
+void bbus_i2c_target_sda_isr(bbus_i2c_target_t *t)
+{
+    uint8_t edge = t->edge;
+
+    t->edge = 0;
+    if (edge)
+    {
+        return; // 引擎在SCL为低时驱动SDA产生的边沿，中断可能延迟到主机拉高SCL之后才执行，不是起始/停止信号
+    }
+    if (!bbus_i2c_port_scl_get(t->lun))
+    {
+        return; // SCL为低时的数据位变化
+    }
+    target_done(t);
+    target_sda(t, 1);
+    if (bbus_i2c_port_sda_get(t->lun))
+    {
+        t->state = T_IDLE; // 停止信号
+    }
+    else
+    {
+        t->state = T_ADDR; // (重复)起始信号，寄存器指针保留，供重复起始后的读取使用
+        t->bits = 0;
+        t->sh = 0;
+    }
+}
@@ -0,0 +1,129 @@
+/**
+ * @file    bbus_i2c_target.h
+ * @version v1.0
+ * @date    2026-10-19
+ * @author  ZeroOneLab
+ * @website https://github.com/ZeroOneLab/BBusI2C.git
+ *
+ * @license MIT License
+ * Copyright (c) 2026 ZeroOneLab
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BBUS_I2C_TARGET_H
+#define BBUS_I2C_TARGET_H
+
+#include "bbus_i2c.h"
+
+typedef struct bbus_i2c_target bbus_i2c_target_t;
+
+/**
+ * @brief   主机读取寄存器回调，在SCL中断中调用
+ * @param   t: 从机
+ * @param   reg: 寄存器地址
+ * @retval  寄存器值
+ */
+typedef uint8_t (*bbus_i2c_target_read_cb_t)(bbus_i2c_target_t *t, uint8_t reg);
+
+/**
+ * @brief   主机写入寄存器回调，在SCL中断中调用
+ * @param   t: 从机
+ * @param   reg: 寄存器地址
+ * @param   data: 写入的值
+ * @retval  无
+ */
+typedef void (*bbus_i2c_target_write_cb_t)(bbus_i2c_target_t *t, uint8_t reg, uint8_t data);
+
+/**
+ * @brief   写事务结束回调(停止信号或重复起始信号)，在SDA中断中调用
+ * @param   t: 从机
+ * @param   reg: 本次写入的第一个寄存器地址
+ * @param   len: 本次写入的字节数
+ * @retval  无
+ */
+typedef void (*bbus_i2c_target_done_cb_t)(bbus_i2c_target_t *t, uint8_t reg, uint8_t len);
+
+/* 从机(目标设备)：由SCL/SDA引脚的双边沿外部中断驱动，表现为带8位寄存器指针的I2C设备 */
+struct bbus_i2c_target
+{
+    uint8_t lun;                         /* 从机使用的引脚(端口层的总线号)，不能同时作为主机总线使用 */
+    uint8_t slave_addr;                  /* 从机地址(8位形式，最低位为0) */
+    uint8_t *regs;                       /* 寄存器文件，回调为NULL时直接读写 */
+    uint16_t size;                       /* 寄存器文件大小 */
+    bbus_i2c_target_read_cb_t read_cb;   /* 读取回调，可为NULL */
+    bbus_i2c_target_write_cb_t write_cb; /* 写入回调，可为NULL */
+    bbus_i2c_target_done_cb_t done_cb;   /* 写事务结束回调，可为NULL */
+    void *user;                          /* 用户数据 */
+    uint8_t stretch;                     /* 1：字节边界调用回调期间拉低SCL(时钟延展) */
+    uint32_t rx_bytes;                   /* 已接收的数据字节数(不含寄存器地址) */
+    uint32_t tx_bytes;                   /* 已发送的字节数 */
+
+    /* 以下为引擎内部状态 */
+    volatile uint8_t state;
+    uint8_t od;
+    uint8_t sda;
+    volatile uint8_t edge; /* 引擎驱动SDA产生的边沿，其中断尚未处理 */
+    uint8_t sh;
+    uint8_t bits;
+    uint8_t reg;
+    uint8_t have_reg;
+    uint8_t wr_reg;
+    uint8_t wr_len;
+};
+
+/**
+ * @brief       初始化从机，释放SCL/SDA
+ * @note        端口需支持 BBUS_I2C_PORT_CAP_SCL_READ，SCL/SDA配置为双边沿外部中断，两个中断优先级相同(互不抢占)
+ * @param       t: 从机
+ * @param       lun: 从机使用的引脚(端口层的总线号)
+ * @param       slave_addr: 从机地址(8位形式)
+ * @param       regs: 寄存器文件，可为NULL(此时需设置回调)
+ * @param       size: 寄存器文件大小
+ * @retval      0，成功；1，端口不支持回读SCL
+ */
+uint8_t bbus_i2c_target_init(bbus_i2c_target_t *t, uint8_t lun, uint8_t slave_addr, uint8_t *regs, uint16_t size);
+
+/**
+ * @brief       设置寄存器访问回调
+ * @param       t: 从机
+ * @param       read_cb: 读取回调，NULL表示直接读取寄存器文件
+ * @param       write_cb: 写入回调，NULL表示直接写入寄存器文件
+ * @param       done_cb: 写事务结束回调，可为NULL
+ * @param       user: 用户数据
+ * @retval      无
+ */
+void bbus_i2c_target_set_callback(bbus_i2c_target_t *t, bbus_i2c_target_read_cb_t read_cb,
+                                  bbus_i2c_target_write_cb_t write_cb, bbus_i2c_target_done_cb_t done_cb, void *user);
+
+/**
+ * @brief       SCL边沿中断处理，在SCL引脚的双边沿外部中断服务函数中调用
+ * @param       t: 从机
+ * @retval      无
+ */
+void bbus_i2c_target_scl_isr(bbus_i2c_target_t *t);
+
+/**
+ * @brief       SDA边沿中断处理，在SDA引脚的双边沿外部中断服务函数中调用；SCL为高时检测起始/停止信号
+ * @param       t: 从机
+ * @retval      无
+ */
+void bbus_i2c_target_sda_isr(bbus_i2c_target_t *t);
+
+#endif
@@ -29,360 +29,1947 @@
 
 #include "bbus_i2c.h"
 
-static uint8_t delay_time[BBUS_I2C_BUS_NUM];
+#define BBUS_I2C_PIN_UNKNOWN 0xFF /* 引脚状态未知，下一次写入必定下发到端口 */
 
-#define SDA_OUT(lun)            bbus_i2c_port_sda_set_out(lun)
-#define SDA_IN(lun)             bbus_i2c_port_sda_set_in(lun)
-#define SDA_SET(lun, level)     bbus_i2c_port_sda_set(lun, level)
-#define SDA_GET(lun)            bbus_i2c_port_sda_get(lun)
-#define SCL_SET(lun, level)     bbus_i2c_port_scl_set(lun, level)
-#define DELAY_US(delay_time)    bbus_i2c_port_delay_us(delay_time)
-#define ENTER_CRITICAL(lun)     bbus_i2c_port_enter_critical(lun)
-#define EXIT_CRITICAL(lun)      bbus_i2c_port_exit_critical(lun)
+/* 每条总线的状态，含引脚状态缓存：记录最近一次驱动的电平与SDA方向，未变化时不再调用端口。
+ * 多线程访问不同总线时按 BBUS_I2C_CACHE_LINE 对齐，避免伪共享 */
+typedef struct
+{
+    uint32_t delay_time; /* 半周期延时(us) */
+    uint8_t scl;     /* 最近一次驱动的SCL电平 */
+    uint8_t sda;     /* 最近一次驱动的SDA电平 */
+    uint8_t sda_out; /* SDA方向，1：输出，0：输入 */
+    uint8_t caps;    /* 端口能力标志 */
+    uint8_t error;   /* 最近一次传输的错误码 BBUS_I2C_ERR_xxx */
+    uint32_t stretch_timeout; /* 时钟延展最长等待时间(us)，0 表示不检测时钟延展 */
+#if BBUS_I2C_USE_MULTI_MASTER
+    uint8_t owner;         /* 本机已产生起始信号，持有总线直到停止信号或仲裁失败 */
+    volatile uint8_t busy; /* 其他主机持有总线(由 bbus_i2c_bus_monitor 更新) */
+#endif
+#if BBUS_I2C_USE_RISE_COMP
+    uint32_t rise_comp; /* SCL释放后额外等待的上升时间补偿(us) */
+    uint32_t rise_tick; /* 最近一次测量上升时间的系统时间ms */
+#endif
+#if BBUS_I2C_USE_STATS
+    uint32_t irq_off_start;   /* 本次关中断的起始周期计数 */
+    bbus_i2c_stats_t stats;
+#endif
+} BBUS_I2C_ALIGNED bbus_i2c_bus_t;
 
-/**
- * @brief   初始化软件I2C
- * @param   无
- * @retval  无
- */
-void bbus_i2c_init(void)
+static bbus_i2c_bus_t bus[BBUS_I2C_BUS_NUM];
+
+#if BBUS_I2C_USE_STATS
+#define STAT_ADD(lun, field, n) (bus[lun].stats.field += (n))
+#else
+#define STAT_ADD(lun, field, n) ((void)0)
+#endif
+
+#define SDA_OUT(lun)            bbus_i2c_sda_out(lun)
+#define SDA_IN(lun)             bbus_i2c_sda_in(lun)
+#define SDA_SET(lun, level)     bbus_i2c_sda_set(lun, level)
+#define SDA_GET(lun)            bbus_i2c_sda_get(lun)
+#define SCL_SET(lun, level)     bbus_i2c_scl_set(lun, level)
+#define SCL_RELEASE(lun)        bbus_i2c_scl_release(lun)
+#define DELAY_US(xus)           bbus_i2c_port_delay_us(xus)
+#define ENTER_CRITICAL(lun)     bbus_i2c_irq_off(lun)
+#define EXIT_CRITICAL(lun)      bbus_i2c_irq_on(lun)
+
+#if (BBUS_I2C_LOCK_MODE == BBUS_I2C_LOCK_TRANSACTION)
+#define XFER_LOCK(lun)          ENTER_CRITICAL(lun)
+#define XFER_UNLOCK(lun)        EXIT_CRITICAL(lun)
+#define BYTE_LOCK(lun)          ((void)0)
+#define BYTE_UNLOCK(lun)        ((void)0)
+/* 按系统时间等待应答时临时开中断，否则SysTick驱动的 bbus_i2c_port_tick_get 不再前进 */
+#define SLOW_UNLOCK(lun)        EXIT_CRITICAL(lun)
+#define SLOW_LOCK(lun)          ENTER_CRITICAL(lun)
+#elif (BBUS_I2C_LOCK_MODE == BBUS_I2C_LOCK_BYTE)
+#define XFER_LOCK(lun)          ((void)0)
+#define XFER_UNLOCK(lun)        ((void)0)
+#define BYTE_LOCK(lun)          ENTER_CRITICAL(lun)
+#define BYTE_UNLOCK(lun)        EXIT_CRITICAL(lun)
+#define SLOW_UNLOCK(lun)        ((void)0)
+#define SLOW_LOCK(lun)          ((void)0)
+#else
+#define XFER_LOCK(lun)          ((void)0)
+#define XFER_UNLOCK(lun)        ((void)0)
+#define BYTE_LOCK(lun)          ((void)0)
+#define BYTE_UNLOCK(lun)        ((void)0)
+#define SLOW_UNLOCK(lun)        ((void)0)
+#define SLOW_LOCK(lun)          ((void)0)
+#endif
+
+static inline void bbus_i2c_scl_set(uint8_t lun, uint8_t level)
 {
-    for (uint8_t i = 0; i < BBUS_I2C_BUS_NUM; i++)
+    if (bus[lun].scl == level)
     {
-        bbus_i2c_port_init(i);
-        delay_time[i] = 0;
+        STAT_ADD(lun, port_calls_saved, 1);
+        return;
     }
+    bus[lun].scl = level;
+    STAT_ADD(lun, port_calls, 1);
+    bbus_i2c_port_scl_set(lun, level);
 }
 
-/**
- * @brief   设置I2C延时时间
- * @param   lun: I2C总线号
- * @param   xus: 延时时间 (单位: us)
- * @retval  无
- */
-void bbus_i2c_set_delay_time(uint8_t lun, uint32_t xus)
+static inline void bbus_i2c_sda_set(uint8_t lun, uint8_t level)
 {
-    delay_time[lun] = xus;
+    if (bus[lun].sda == level)
+    {
+        STAT_ADD(lun, port_calls_saved, 1);
+        return;
+    }
+    bus[lun].sda = level;
+    STAT_ADD(lun, port_calls, 1);
+    bbus_i2c_port_sda_set(lun, level);
 }
 
-/**
- * @brief   产生I2C起始信号
- * @param   lun: I2C总线号
- * @retval  无
- */
-void bbus_i2c_start(uint8_t lun)
+static inline uint8_t bbus_i2c_sda_get(uint8_t lun)
 {
-    SDA_OUT(lun);
-    SDA_SET(lun, 1);
-    SCL_SET(lun, 1);
-    DELAY_US(delay_time[lun]);
-    SDA_SET(lun, 0); /* START信号: 当SCL为高时, SDA从高变成低, 表示起始信号 */
-    DELAY_US(delay_time[lun]);
-    SCL_SET(lun, 0); /* 钳住I2C总线，准备发送或接收数据 */
+    STAT_ADD(lun, port_calls, 1);
+    return bbus_i2c_port_sda_get(lun);
 }
 
-/**
- * @brief       产生I2C停止信号
- * @param       lun: I2C总线号
- * @retval      无
- */
-void bbus_i2c_stop(uint8_t lun)
+static inline void bbus_i2c_sda_out(uint8_t lun)
 {
-    SDA_OUT(lun);
-    SDA_SET(lun, 0); /* STOP信号: 当SCL为高时, SDA从低变成高, 表示停止信号 */
-    SCL_SET(lun, 0); /* STOP信号: 当SCL为高时, SDA从低变成高, 表示停止信号 */
-    DELAY_US(delay_time[lun]);
-    SCL_SET(lun, 1);
-    SDA_SET(lun, 1); /* 发送I2C总线结束信号 */
-    DELAY_US(delay_time[lun]);
+    /* 开漏端口读写共用同一引脚模式，无需切换方向 */
+    if ((bus[lun].caps & BBUS_I2C_PORT_CAP_OPEN_DRAIN) || bus[lun].sda_out == 1)
+    {
+        STAT_ADD(lun, port_calls_saved, 1);
+        return;
+    }
+    bus[lun].sda_out = 1;
+    STAT_ADD(lun, port_calls, 1);
+    bbus_i2c_port_sda_set_out(lun);
+}
+
+static inline void bbus_i2c_sda_in(uint8_t lun)
+{
+    if ((bus[lun].caps & BBUS_I2C_PORT_CAP_OPEN_DRAIN) || bus[lun].sda_out == 0)
+    {
+        STAT_ADD(lun, port_calls_saved, 1);
+        return;
+    }
+    bus[lun].sda_out = 0;
+    STAT_ADD(lun, port_calls, 1);
+    bbus_i2c_port_sda_set_in(lun);
+}
+
+static inline void bbus_i2c_irq_off(uint8_t lun)
+{
+    bbus_i2c_port_enter_critical(lun);
+#if BBUS_I2C_USE_STATS
+    bus[lun].irq_off_start = bbus_i2c_port_cycle_get();
+#endif
+}
+
+static inline void bbus_i2c_irq_on(uint8_t lun)
+{
+#if BBUS_I2C_USE_STATS
+    uint32_t window = bbus_i2c_port_cycle_get() - bus[lun].irq_off_start;
+
+    if (window > bus[lun].stats.irq_off_max)
+    {
+        bus[lun].stats.irq_off_max = window;
+    }
+#endif
+    bbus_i2c_port_exit_critical(lun);
 }
 
 /**
- * @brief       等待应答信号到来
+ * @brief       等待从机释放SCL（时钟延展），超过 stretch_timeout 后记录错误
  * @param       lun: I2C总线号
- * @param       timeout: 超时时间ms
- * @retval      1，接收应答失败
- *              0，接收应答成功
+ * @retval      0，SCL已变高；1，等待超时
  */
-uint8_t bbus_i2c_wait_ack(uint8_t lun, uint32_t timeout)
+static uint8_t bbus_i2c_stretch_wait(uint8_t lun)
 {
-    uint32_t wait_time = bbus_i2c_port_tick_get();
+    uint32_t left = bus[lun].stretch_timeout;
 
-    SDA_IN(lun);     /* 设置SDA为输入模式 */
-    SDA_SET(lun, 1); /* 主机释放SDA线(此时外部器件可以拉低SDA线) */
-    DELAY_US(delay_time[lun]);
-    SCL_SET(lun, 1); /* SCL=1, 此时从机可以返回ACK */
-    DELAY_US(delay_time[lun]);
-    while (SDA_GET(lun)) /* 等待应答 */
+    if (bbus_i2c_port_scl_get(lun))
     {
-        if ((bbus_i2c_port_tick_get() - wait_time) >= timeout)
+        return 0;
+    }
+    STAT_ADD(lun, stretch_events, 1);
+    while (!bbus_i2c_port_scl_get(lun))
+    {
+        if (left == 0)
         {
-            bbus_i2c_stop(lun);
+            bus[lun].error = BBUS_I2C_ERR_STRETCH_TIMEOUT;
+            STAT_ADD(lun, stretch_timeouts, 1);
             return 1;
         }
+        bbus_i2c_port_delay_us(1);
+        left--;
     }
-    SCL_SET(lun, 0); /* SCL=0, 结束ACK检查 */
     return 0;
 }
 
-/**
- * @brief       产生ACK应答
- * @param       lun: I2C总线号
- * @retval      无
- */
-void bbus_i2c_ack(uint8_t lun)
+static inline uint8_t bbus_i2c_stretch_enabled(uint8_t lun)
 {
-    SCL_SET(lun, 0); /* SCL 0 -> 1 时 SDA = 0,表示应答 */
-    SDA_OUT(lun);
-    DELAY_US(delay_time[lun]);
-    SDA_SET(lun, 0); /* SCL 0 -> 1 时 SDA = 0,表示应答 */
-    DELAY_US(delay_time[lun]);
-    SCL_SET(lun, 1); /* 产生一个时钟 */
-    DELAY_US(delay_time[lun]);
-    SCL_SET(lun, 0);
+    return (bus[lun].caps & BBUS_I2C_PORT_CAP_SCL_READ) && bus[lun].stretch_timeout;
 }
 
 /**
- * @brief       不产生ACK应答
+ * @brief       SCL释放后的同步：开启时钟延展检测时回读SCL直到真正变高，否则按测得的上升时间补偿
  * @param       lun: I2C总线号
- * @retval      无
+ * @retval      0，成功；1，时钟延展超时
  */
-void bbus_i2c_nack(uint8_t lun)
+static inline uint8_t bbus_i2c_scl_sync(uint8_t lun)
 {
-    SCL_SET(lun, 0); /* 产生一个时钟 */
-    SDA_OUT(lun);
-    SDA_SET(lun, 1); /* SCL 0 -> 1  时 SDA = 1,表示不应答 */
-    DELAY_US(delay_time[lun]);
-    SCL_SET(lun, 1); /* 产生一个时钟 */
-    DELAY_US(delay_time[lun]);
-    SCL_SET(lun, 0);
+    if (bbus_i2c_stretch_enabled(lun))
+    {
+        return bbus_i2c_stretch_wait(lun);
+    }
+#if BBUS_I2C_USE_RISE_COMP
+    if (bus[lun].rise_comp)
+    {
+        DELAY_US(bus[lun].rise_comp);
+    }
+#endif
+    return 0;
+}
+
+static inline uint8_t bbus_i2c_scl_release(uint8_t lun)
+{
+    SCL_SET(lun, 1);
+    return bbus_i2c_scl_sync(lun);
 }
 
+/*
+ * 字节收发内核：8个数据位完全展开，移位寄存器取位/拼位，数据位路径无分支。
+ * 内核直接调用端口函数（SCL在每个时钟内必然翻转），结束后统一回写引脚状态缓存。
+ * delay为0时使用无延时版本，省去每个半周期的延时函数调用；
+ * 开启时钟延展检测时使用在每个SCL上升沿后回读SCL的版本，第一次等待超时即停止，不再继续产生时钟。
+ */
+#define KERNEL_TX_BIT(lun, sr, n, WAIT, SYNC)                         \
+    do                                                                \
+    {                                                                 \
+        bbus_i2c_port_sda_set(lun, (uint8_t)(((sr) >> (n)) & 1u));    \
+        WAIT;                                                         \
+        bbus_i2c_port_scl_set(lun, 1);                                \
+        SYNC;                                                         \
+        WAIT;                                                         \
+        bbus_i2c_port_scl_set(lun, 0);                                \
+    } while (0)
+
+#define KERNEL_RX_BIT(lun, sr, WAIT, SYNC)                            \
+    do                                                                \
+    {                                                                 \
+        WAIT;                                                         \
+        bbus_i2c_port_scl_set(lun, 1);                                \
+        SYNC;                                                         \
+        WAIT;                                                         \
+        (sr) = ((sr) << 1) | (bbus_i2c_port_sda_get(lun) & 1u);       \
+        bbus_i2c_port_scl_set(lun, 0);                                \
+    } while (0)
+
+#define KERNEL_TX_BYTE(lun, sr, WAIT, SYNC)                           \
+    do                                                                \
+    {                                                                 \
+        KERNEL_TX_BIT(lun, sr, 7, WAIT, SYNC);                        \
+        KERNEL_TX_BIT(lun, sr, 6, WAIT, SYNC);                        \
+        KERNEL_TX_BIT(lun, sr, 5, WAIT, SYNC);                        \
+        KERNEL_TX_BIT(lun, sr, 4, WAIT, SYNC);                        \
+        KERNEL_TX_BIT(lun, sr, 3, WAIT, SYNC);                        \
+        KERNEL_TX_BIT(lun, sr, 2, WAIT, SYNC);                        \
+        KERNEL_TX_BIT(lun, sr, 1, WAIT, SYNC);                        \
+        KERNEL_TX_BIT(lun, sr, 0, WAIT, SYNC);                        \
+    } while (0)
+
+#define KERNEL_RX_BYTE(lun, sr, WAIT, SYNC)                           \
+    do                                                                \
+    {                                                                 \
+        KERNEL_RX_BIT(lun, sr, WAIT, SYNC);                           \
+        KERNEL_RX_BIT(lun, sr, WAIT, SYNC);                           \
+        KERNEL_RX_BIT(lun, sr, WAIT, SYNC);                           \
+        KERNEL_RX_BIT(lun, sr, WAIT, SYNC);                           \
+        KERNEL_RX_BIT(lun, sr, WAIT, SYNC);                           \
+        KERNEL_RX_BIT(lun, sr, WAIT, SYNC);                           \
+        KERNEL_RX_BIT(lun, sr, WAIT, SYNC);                           \
+        KERNEL_RX_BIT(lun, sr, WAIT, SYNC);                           \
+    } while (0)
+
+#define KERNEL_NO_WAIT ((void)0)
+#define KERNEL_NO_SYNC ((void)0)
+#define KERNEL_RX_STRETCH_TIMEOUT 0x100u /* kernel_rx8/rx9 返回值：本字节时钟延展超时 */
+#define KERNEL_STRETCH_SYNC(lun)  \
+    if (bbus_i2c_stretch_wait(lun)) \
+    goto stretch_timeout
+
 /**
- * @brief       I2C发送一个字节
+ * @brief       时钟延展超时后停止字节收发：SCL已释放但被从机拉住，SDA电平以后重新下发
  * @param       lun: I2C总线号
- * @param       data: 要发送的数据
  * @retval      无
  */
-void bbus_i2c_send_byte(uint8_t lun, const uint8_t data)
+static void bbus_i2c_kernel_abort(uint8_t lun)
 {
-    SDA_OUT(lun);
-    SCL_SET(lun, 0); /* 产生一个时钟 */
-    for (uint8_t i = 0; i < 8; i++)
-    {
-        SDA_SET(lun, (((data << i) & 0x80) >> 7));
-
-        DELAY_US(delay_time[lun]);
-        SCL_SET(lun, 1);
-        DELAY_US(delay_time[lun]);
-        SCL_SET(lun, 0);
-    }
+    bus[lun].scl = 1;
+    bus[lun].sda = BBUS_I2C_PIN_UNKNOWN;
 }
 
-/**
- * @brief       I2C读取一个字节
- * @param       lun: I2C总线号
- * @param       ack:  ack=1时，发送ack; ack=0时，发送nack
- * @retval      接收到的数据
- */
-uint8_t bbus_i2c_read_byte(uint8_t lun, uint8_t ack)
+#if !BBUS_I2C_USE_MULTI_MASTER
+static uint8_t bbus_i2c_kernel_tx8(uint8_t lun, uint32_t sr, uint32_t dly)
 {
-    uint8_t i, receive = 0;
-    SDA_SET(lun, 1);
-    SDA_IN(lun);            /* 设置SDA为输入模式 */
-    for (i = 0; i < 8; i++) /* 接收1个字节数据 */
+    if (bbus_i2c_stretch_enabled(lun))
+    {
+        KERNEL_TX_BYTE(lun, sr, DELAY_US(dly), KERNEL_STRETCH_SYNC(lun));
+    }
+#if BBUS_I2C_USE_RISE_COMP
+    else if (bus[lun].rise_comp)
+    {
+        KERNEL_TX_BYTE(lun, sr, DELAY_US(dly), DELAY_US(bus[lun].rise_comp));
+    }
+#endif
+    else if (dly == 0)
+    {
+        KERNEL_TX_BYTE(lun, sr, KERNEL_NO_WAIT, KERNEL_NO_SYNC);
+    }
+    else
     {
+        KERNEL_TX_BYTE(lun, sr, DELAY_US(dly), KERNEL_NO_SYNC);
+    }
+    bus[lun].scl = 0;
+    bus[lun].sda = (uint8_t)(sr & 1u);
+    STAT_ADD(lun, port_calls, 8 * 3);
+    return 0;
 
-        SCL_SET(lun, 0);
-        DELAY_US(delay_time[lun]);
-        SCL_SET(lun, 1);
-        receive <<= 1; /* 高位先输出,所以先收到的数据位要左移 */
+stretch_timeout:
+    bbus_i2c_kernel_abort(lun);
+    return 1;
+}
+#endif
 
-        if (SDA_GET(lun))
-        {
-            receive++;
-        }
-        DELAY_US(delay_time[lun]);
+static uint32_t bbus_i2c_kernel_rx8(uint8_t lun, uint32_t dly)
+{
+    uint32_t sr = 0;
+
+    if (bbus_i2c_stretch_enabled(lun))
+    {
+        KERNEL_RX_BYTE(lun, sr, DELAY_US(dly), KERNEL_STRETCH_SYNC(lun));
+    }
+#if BBUS_I2C_USE_RISE_COMP
+    else if (bus[lun].rise_comp)
+    {
+        KERNEL_RX_BYTE(lun, sr, DELAY_US(dly), DELAY_US(bus[lun].rise_comp));
     }
-    if (!ack)
+#endif
+    else if (dly == 0)
     {
-        bbus_i2c_nack(lun); /* 发送nACK */
+        KERNEL_RX_BYTE(lun, sr, KERNEL_NO_WAIT, KERNEL_NO_SYNC);
     }
     else
     {
-        bbus_i2c_ack(lun); /* 发送ACK */
+        KERNEL_RX_BYTE(lun, sr, DELAY_US(dly), KERNEL_NO_SYNC);
     }
+    bus[lun].scl = 0;
+    STAT_ADD(lun, port_calls, 8 * 3);
+    return sr & 0xFFu;
 
-    return receive;
+stretch_timeout:
+    bbus_i2c_kernel_abort(lun);
+    return (sr & 0xFFu) | KERNEL_RX_STRETCH_TIMEOUT;
 }
 
+#if BBUS_I2C_USE_MULTI_MASTER
 /**
- * @brief       检查从设备地址是否正确
+ * @brief       仲裁检测版本的8位发送：每个数据位在SCL高电平末尾回读SDA，
+ *              驱动为1却读到0说明另一主机正在发送0，本机仲裁失败，立即释放SCL/SDA
  * @param       lun: I2C总线号
- * @param       slave_addr: 从设备地址
- * @param       timeout: 超时时间ms
- * @retval      0，读取成功；1，读取失败
+ * @param       sr: 要发送的数据
+ * @param       dly: 半周期延时(us)
+ * @retval      0，发送完成；1，仲裁失败、时钟延展超时或未持有总线
  */
-uint8_t bbus_i2c_check_address(uint8_t lun, uint8_t slave_addr, uint32_t timeout)
+static uint8_t bbus_i2c_kernel_tx8_arb(uint8_t lun, uint32_t sr, uint32_t dly)
 {
-    ENTER_CRITICAL(lun);
+    uint8_t bit;
 
-    bbus_i2c_start(lun);
-    bbus_i2c_send_byte(lun, slave_addr & 0xFE);
-
-    if (bbus_i2c_wait_ack(lun, timeout))
+    if (!bus[lun].owner)
     {
-        bbus_i2c_stop(lun);
-        BBUS_I2C_LOG("[I2C Check][ERROR]: Wait ACK failed for address 0x%02X\n", slave_addr);
-        return 1; // 接收应答失败
+        return 1;
     }
-
-    bbus_i2c_stop(lun);
-
-    EXIT_CRITICAL(lun);
+    for (int8_t n = 7; n >= 0; n--)
+    {
+        bit = (uint8_t)((sr >> n) & 1u);
+        bbus_i2c_port_sda_set(lun, bit);
+        DELAY_US(dly);
+        bbus_i2c_port_scl_set(lun, 1);
+        if (bbus_i2c_scl_sync(lun)) // 时钟同步：其他主机拉低SCL时等待
+        {
+            bbus_i2c_kernel_abort(lun);
+            return 1;
+        }
+        DELAY_US(dly);
+        if (bit && !bbus_i2c_port_sda_get(lun))
+        {
+            bbus_i2c_port_sda_set(lun, 1);
+            bus[lun].scl = 1;
+            bus[lun].sda = 1;
+            bus[lun].owner = 0;
+            bus[lun].error = BBUS_I2C_ERR_ARB_LOST;
+            STAT_ADD(lun, arb_lost, 1);
+            STAT_ADD(lun, port_calls, (uint32_t)(8 - n) * 4);
+            return 1;
+        }
+        bbus_i2c_port_scl_set(lun, 0);
+    }
+    bus[lun].scl = 0;
+    bus[lun].sda = (uint8_t)(sr & 1u);
+    STAT_ADD(lun, port_calls, 8 * 4);
     return 0;
 }
 
 /**
- * @brief       软件I2C连续写数据
+ * @brief       等待总线空闲：SCL与SDA同时保持高电平超过 BBUS_I2C_BUS_FREE_US 加一个SCL周期，
+ *              且 bbus_i2c_bus_monitor 未标记总线忙
  * @param       lun: I2C总线号
- * @param       salve_adress: 从设备地址
- * @param       reg_address: 寄存器地址
- * @param       data: 存储读取数据的缓冲区
- * @param       len: 要读取的数据长度
  * @param       timeout: 超时时间ms
- * @retval      0，读取成功；1，读取失败
+ * @retval      0，总线空闲；1，超时
  */
-uint8_t bbus_i2c_write_data(uint8_t lun, uint8_t slave_addr, uint8_t reg_address, const uint8_t *data, uint8_t len, uint32_t timeout)
+static uint8_t bbus_i2c_wait_idle(uint8_t lun, uint32_t timeout)
 {
-    ENTER_CRITICAL(lun);
-    // 产生起始信号
-    bbus_i2c_start(lun);
-
-    // 发送从设备地址 + 写命令
-    bbus_i2c_send_byte(lun, slave_addr & 0xFE);
-    if (bbus_i2c_wait_ack(lun, timeout))
-    {
-        bbus_i2c_stop(lun);
-        BBUS_I2C_LOG("[I2C Write][ERROR]: Wait ACK failed for address 0x%02X\n", slave_addr);
-        return 1; // 接收应答失败
-    }
-
-    // 发送寄存器地址
-    bbus_i2c_send_byte(lun, reg_address);
-    if (bbus_i2c_wait_ack(lun, timeout))
-    {
-        bbus_i2c_stop(lun);
-        BBUS_I2C_LOG("[I2C Write][ERROR]: Wait ACK failed for register 0x%02X\n", reg_address);
-        return 1; // 接收应答失败
-    }
+    uint32_t need = BBUS_I2C_BUS_FREE_US + 2 * bus[lun].delay_time;
+    uint32_t idle = 0, start = bbus_i2c_port_tick_get();
+    uint8_t scl_read = bus[lun].caps & BBUS_I2C_PORT_CAP_SCL_READ, waited = 0;
 
-    // 发送数据
-    for (uint8_t i = 0; i < len; i++)
+    while (idle < need)
     {
-        bbus_i2c_send_byte(lun, data[i]);
-        if (bbus_i2c_wait_ack(lun, timeout))
+        if (!bus[lun].busy && (!scl_read || bbus_i2c_port_scl_get(lun)) && bbus_i2c_port_sda_get(lun))
         {
-            bbus_i2c_stop(lun);
-            BBUS_I2C_LOG("[I2C Write][ERROR]: Wait ACK failed for data 0x%02X\n", data[i]);
-            return 1; // 接收应答失败
+            idle++;
+        }
+        else
+        {
+            idle = 0;
+            waited = 1;
+            if ((bbus_i2c_port_tick_get() - start) >= timeout)
+            {
+                bus[lun].error = BBUS_I2C_ERR_BUS_BUSY;
+                BBUS_I2C_LOG("[I2C Arb][ERROR]: Bus %d held by another master\n", lun);
+                return 1;
+            }
         }
+        DELAY_US(1);
+    }
+    if (waited)
+    {
+        STAT_ADD(lun, busy_waits, 1);
     }
-
-    // 产生停止信号
-    bbus_i2c_stop(lun);
-    EXIT_CRITICAL(lun);
-
     return 0;
 }
 
 /**
- * @brief       软件I2C连续读数据
+ * @brief       仲裁失败后的退避：等待时间随重试次数增加，之后的 bbus_i2c_xfer_begin 再等待总线空闲
  * @param       lun: I2C总线号
- * @param       salve_adress: 从设备地址
- * @param       reg_address: 寄存器地址
- * @param       data: 存储读取数据的缓冲区
- * @param       len: 要读取的数据长度
- * @param       timeout: 超时时间ms
- * @retval      0，读取成功；1，读取失败
+ * @param       attempt: 第几次重试，从1开始
+ * @retval      无
  */
-uint8_t bbus_i2c_read_data(uint8_t lun, uint8_t slave_addr, uint8_t reg_address, uint8_t *data, uint8_t len, uint32_t timeout)
+static void bbus_i2c_arb_backoff(uint8_t lun, uint8_t attempt)
 {
-    ENTER_CRITICAL(lun);
-    // 产生起始信号
-    bbus_i2c_start(lun);
+    DELAY_US(attempt * (BBUS_I2C_BUS_FREE_US + 18 * bus[lun].delay_time));
+}
+
+/* 仲裁失败时退避并重新执行整个传输，其他错误直接返回 */
+#define ARB_RETRY(lun, call)                                                               \
+    do                                                                                     \
+    {                                                                                      \
+        uint8_t ret_ = (call);                                                             \
+        for (uint8_t try_ = 1; ret_ == 1 && bus[lun].error == BBUS_I2C_ERR_ARB_LOST &&     \
+                               try_ <= BBUS_I2C_ARB_RETRIES; try_++)                       \
+        {                                                                                  \
+            BBUS_I2C_LOG("[I2C Arb][WARN]: Arbitration lost on bus %d, retry %d\n", lun, try_); \
+            bbus_i2c_arb_backoff(lun, try_);                                               \
+            ret_ = (call);                                                                 \
+        }                                                                                  \
+        return ret_;                                                                       \
+    } while (0)
+#else
+#define ARB_RETRY(lun, call) return (call)
+#endif
+
+/**
+ * @brief       9时钟发送：8个数据位 + 读取ACK位
+ * @param       lun: I2C总线号
+ * @param       data: 要发送的数据
+ * @param       dly: 半周期延时(us)
+ * @param       timeout: 等待ACK超时时间ms
+ * @retval      1，接收应答失败, 0，接收应答成功
+ */
+static uint8_t bbus_i2c_tx9(uint8_t lun, uint8_t data, uint32_t dly, uint32_t timeout)
+{
+    uint8_t nack;
 
-    // 发送从设备地址 + 写命令
-    bbus_i2c_send_byte(lun, slave_addr & 0xFE);
-    if (bbus_i2c_wait_ack(lun, timeout))
+    BYTE_LOCK(lun);
+    SCL_SET(lun, 0);
+    SDA_OUT(lun);
+#if BBUS_I2C_USE_MULTI_MASTER
+    if (bbus_i2c_kernel_tx8_arb(lun, data, dly))
+#else
+    if (bbus_i2c_kernel_tx8(lun, data, dly))
+#endif
     {
-        bbus_i2c_stop(lun);
-        BBUS_I2C_LOG("[I2C Read][ERROR]: Wait ACK failed for address 0x%02X\n", slave_addr);
-        return 1; // 接收应答失败
+        BYTE_UNLOCK(lun);
+        return 1; // 仲裁失败(总线已释放)或时钟延展超时
     }
-    // 发送寄存器地址
-    bbus_i2c_send_byte(lun, reg_address);
-    if (bbus_i2c_wait_ack(lun, timeout))
+    STAT_ADD(lun, bytes, 1);
+
+    /* 第9个时钟：释放SDA，由从机拉低表示应答(先切为输入再置高，推挽时不会主动驱动高电平) */
+    SDA_IN(lun);
+    SDA_SET(lun, 1);
+    DELAY_US(dly);
+    if (SCL_RELEASE(lun))
     {
-        bbus_i2c_stop(lun);
-        BBUS_I2C_LOG("[I2C Read][ERROR]: Wait ACK failed for register 0x%02X\n", reg_address);
-        return 1; // 接收应答失败
+        BYTE_UNLOCK(lun);
+        return 1; // 时钟延展超时
     }
-    // 产生起始信号
-    bbus_i2c_start(lun);
-    // 发送从设备地址 + 读命令
-    bbus_i2c_send_byte(lun, slave_addr | 0x01);
-    if (bbus_i2c_wait_ack(lun, timeout))
+    DELAY_US(dly);
+    nack = SDA_GET(lun);
+    if (nack == 0)
     {
-        bbus_i2c_stop(lun);
-        BBUS_I2C_LOG("[I2C Read][ERROR]: Wait ACK failed for address 0x%02X in read mode\n", slave_addr);
-        return 1; // 接收应答失败
+        SCL_SET(lun, 0);
+        BYTE_UNLOCK(lun);
+        return bus[lun].error != BBUS_I2C_ERR_NONE;
     }
+    BYTE_UNLOCK(lun);
 
-    // 读取数据
-    for (uint8_t i = 0; i < len; i++)
+    /* 慢速路径：在超时时间内继续等待应答，SCL保持高电平；
+     * 按系统时间计时，事务级关中断时也须临时开中断 */
+    SLOW_UNLOCK(lun);
+    uint32_t wait_time = bbus_i2c_port_tick_get();
+    while ((nack = SDA_GET(lun)) != 0)
     {
-        data[i] = bbus_i2c_read_byte(lun, i < len - 1 ? 1 : 0);
+        if ((bbus_i2c_port_tick_get() - wait_time) >= timeout)
+        {
+            break;
+        }
     }
-
-    // 产生停止信号
-    bbus_i2c_stop(lun);
-    EXIT_CRITICAL(lun);
-
-    return 0; // 读取成功
+    SLOW_LOCK(lun);
+    SCL_SET(lun, 0);
+    if (nack)
+    {
+        bus[lun].error = BBUS_I2C_ERR_NACK;
+    }
+    return nack || bus[lun].error;
 }
 
 /**
- * @brief       直接读 N 字节序列（无寄存器地址阶段）
+ * @brief       9时钟接收：8个数据位 + 发送ACK/NACK位
  * @param       lun: I2C总线号
- * @param       salve_adress: 从设备地址
- * @param       data: 存储读取数据的缓冲区
- * @param       len: 要读取的数据长度
- * @param       timeout: 超时时间ms
- * @retval      0，读取成功；1，读取失败
+ * @param       ack: ack=1时，发送ack; ack=0时，发送nack
+ * @param       dly: 半周期延时(us)
+ * @retval      低8位为接收到的数据；本字节时钟延展超时时置位 KERNEL_RX_STRETCH_TIMEOUT
  */
-uint8_t bbus_i2c_read_seq(uint8_t lun, uint8_t slave_addr, uint8_t *data, uint8_t len, uint32_t timeout)
+static uint32_t bbus_i2c_rx9(uint8_t lun, uint8_t ack, uint32_t dly)
 {
-    ENTER_CRITICAL(lun);
-    // 产生起始信号
-    bbus_i2c_start(lun);
-    // 发送从设备地址 + 读命令
-    bbus_i2c_send_byte(lun, slave_addr | 0x01);
-    if (bbus_i2c_wait_ack(lun, timeout))
+    uint32_t receive;
+
+    BYTE_LOCK(lun);
+    SCL_SET(lun, 0);
+    SDA_IN(lun);
+    SDA_SET(lun, 1);
+    receive = bbus_i2c_kernel_rx8(lun, dly);
+    if (receive & KERNEL_RX_STRETCH_TIMEOUT)
     {
-        bbus_i2c_stop(lun);
-        BBUS_I2C_LOG("[I2C Read][ERROR]: Wait ACK failed for address 0x%02X in read mode\n", slave_addr);
-        return 1; // 接收应答失败
+        BYTE_UNLOCK(lun);
+        return receive; // 时钟延展超时，不再产生应答时钟
     }
-    // 读取数据
-    for (uint8_t i = 0; i < len; i++)
+    STAT_ADD(lun, bytes, 1);
+
+    /* 第9个时钟：SDA=0表示应答，SDA=1表示不应答 */
+    SDA_OUT(lun);
+    SDA_SET(lun, (uint8_t)(ack == 0));
+    DELAY_US(dly);
+    SCL_RELEASE(lun);
+    DELAY_US(dly);
+    SCL_SET(lun, 0);
+    BYTE_UNLOCK(lun);
+    return receive;
+}
+
+static void bbus_i2c_start_dly(uint8_t lun, uint32_t dly)
+{
+    SDA_OUT(lun);
+    SDA_SET(lun, 1);
+    SCL_RELEASE(lun);
+    DELAY_US(dly);
+#if BBUS_I2C_USE_MULTI_MASTER
+    if (!bus[lun].owner && !SDA_GET(lun))
     {
-        data[i] = bbus_i2c_read_byte(lun, i < len - 1 ? 1 : 0);
+        bus[lun].error = BBUS_I2C_ERR_ARB_LOST; // 其他主机抢先产生了起始信号
+        STAT_ADD(lun, arb_lost, 1);
+        return;
     }
+    bus[lun].owner = 1;
+#endif
+    SDA_SET(lun, 0); /* START信号: 当SCL为高时, SDA从高变成低, 表示起始信号 */
+    DELAY_US(dly);
+    SCL_SET(lun, 0); /* 钳住I2C总线，准备发送或接收数据 */
+}
 
-    // 产生停止信号
-    bbus_i2c_stop(lun);
-    EXIT_CRITICAL(lun);
+static void bbus_i2c_stop_dly(uint8_t lun, uint32_t dly)
+{
+#if BBUS_I2C_USE_MULTI_MASTER
+    if (!bus[lun].owner)
+    {
+        return; // 仲裁失败或未取得总线，线路已释放
+    }
+#endif
+    SDA_OUT(lun);
+    SDA_SET(lun, 0); /* STOP信号: 当SCL为高时, SDA从低变成高, 表示停止信号 */
+    SCL_SET(lun, 0); /* STOP信号: 当SCL为高时, SDA从低变成高, 表示停止信号 */
+    DELAY_US(dly);
+    SCL_RELEASE(lun);
+    SDA_SET(lun, 1); /* 发送I2C总线结束信号 */
+    DELAY_US(dly);
+#if BBUS_I2C_USE_MULTI_MASTER
+    bus[lun].owner = 0;
+#endif
+}
 
-    return 0; // 读取成功
+#define SEQ_START 0x100u /* 头部序列标记：发送该字节前先产生(重复)起始信号 */
+
+/**
+ * @brief       按预先编码的头部序列连续发送，一次循环完成地址、寄存器与重复起始
+ * @param       lun: I2C总线号
+ * @param       seq: 头部序列，低8位为字节，SEQ_START 表示该字节前产生起始信号
+ * @param       n: 序列长度
+ * @param       dly: 半周期延时(us)
+ * @param       timeout: 等待ACK超时时间ms
+ * @retval      全部应答返回 n，否则返回未应答字节的下标
+ */
+static uint8_t bbus_i2c_send_seq(uint8_t lun, const uint16_t *seq, uint8_t n, uint32_t dly, uint32_t timeout)
+{
+    uint8_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        if (seq[i] & SEQ_START)
+        {
+            bbus_i2c_start_dly(lun, dly);
+        }
+        if (bbus_i2c_tx9(lun, (uint8_t)seq[i], dly, timeout))
+        {
+            break;
+        }
+    }
+    return i;
+}
+
+/**
+ * @brief       生成从设备地址(写)的头部序列
+ * @param       seq: 头部序列缓冲区，至少2个元素
+ * @param       slave_addr: 从设备地址，10位地址为 11110xx0 + 低8位两个字节
+ * @retval      序列长度：7位地址为1，10位地址为2
+ */
+static uint8_t bbus_i2c_addr_seq(uint16_t *seq, uint16_t slave_addr)
+{
+    if (slave_addr & BBUS_I2C_ADDR_10BIT)
+    {
+        seq[0] = SEQ_START | 0xF0 | ((slave_addr >> 7) & 0x06);
+        seq[1] = slave_addr & 0xFF;
+        return 2;
+    }
+    seq[0] = SEQ_START | (slave_addr & 0xFE);
+    return 1;
+}
+
+/**
+ * @brief       重复起始信号后的从设备地址(读)
+ * @param       slave_addr: 从设备地址，10位地址只需重发 11110xx1 一个字节
+ * @retval      头部序列元素
+ */
+static uint16_t bbus_i2c_addr_rd(uint16_t slave_addr)
+{
+    if (slave_addr & BBUS_I2C_ADDR_10BIT)
+    {
+        return SEQ_START | 0xF1 | ((slave_addr >> 7) & 0x06);
+    }
+    return SEQ_START | (slave_addr & 0xFF) | 0x01;
+}
+
+static void bbus_i2c_recv_stream(uint8_t lun, uint8_t *data, uint8_t len, uint32_t dly)
+{
+    uint32_t receive;
+
+    for (uint8_t i = 0; i < len; i++)
+    {
+        receive = bbus_i2c_rx9(lun, i < len - 1 ? 1 : 0, dly);
+        data[i] = (uint8_t)receive;
+        if (receive & KERNEL_RX_STRETCH_TIMEOUT)
+        {
+            return; // 从机一直拉住SCL，立即结束读取
+        }
+    }
+}
+
+#if BBUS_I2C_USE_RISE_COMP
+/**
+ * @brief       测量SCL上升时间：拉低SCL后释放，用周期计数器计时直到回读为高，
+ *              按四舍五入换算为微秒作为每个高电平的补偿时间
+ * @note        调用者须已独占总线且总线空闲；SDA保持不变，不会产生起始/停止信号
+ * @param       lun: I2C总线号
+ * @retval      0，成功；1，SCL被拉住或上升时间超过 BBUS_I2C_RISE_MAX_US
+ */
+static uint8_t bbus_i2c_rise_measure(uint8_t lun)
+{
+    uint32_t start, rise = 0, polls = 0;
+    uint8_t ret = 0;
+
+    bus[lun].rise_tick = bbus_i2c_port_tick_get();
+    if (!(bus[lun].caps & BBUS_I2C_PORT_CAP_SCL_READ))
+    {
+        return 1;
+    }
+    ENTER_CRITICAL(lun);
+    SCL_SET(lun, 1);
+    if (!bbus_i2c_port_scl_get(lun))
+    {
+        ret = 1; // SCL被其他器件拉住
+    }
+    else
+    {
+        SCL_SET(lun, 0);
+        DELAY_US(1);
+        start = bbus_i2c_port_cycle_get();
+        SCL_SET(lun, 1);
+        while (!bbus_i2c_port_scl_get(lun))
+        {
+            rise = bbus_i2c_port_cycle_get() - start;
+            /* 每次回读至少耗时一个CPU周期，次数上限保证周期计数器未运行时也能退出 */
+            if (rise > BBUS_I2C_RISE_MAX_US * BBUS_I2C_CYCLES_PER_US ||
+                ++polls > BBUS_I2C_RISE_MAX_US * BBUS_I2C_CYCLES_PER_US)
+            {
+                ret = 1;
+                break;
+            }
+        }
+    }
+    EXIT_CRITICAL(lun);
+    if (ret)
+    {
+        STAT_ADD(lun, rise_failures, 1);
+        BBUS_I2C_LOG("[I2C Rise][ERROR]: SCL of bus %d did not rise within %d us\n", lun, BBUS_I2C_RISE_MAX_US);
+        return 1;
+    }
+    bus[lun].rise_comp = (rise + BBUS_I2C_CYCLES_PER_US / 2) / BBUS_I2C_CYCLES_PER_US;
+#if BBUS_I2C_USE_STATS
+    bus[lun].stats.rise_cycles = rise;
+    if (rise > bus[lun].stats.rise_max)
+    {
+        bus[lun].stats.rise_max = rise;
+    }
+    bus[lun].stats.rise_measures++;
+#endif
+    return 0;
+}
+#endif
+
+/**
+ * @brief       开始一次传输：获取总线互斥锁，事务级加锁时关闭中断
+ * @param       lun: I2C总线号
+ * @param       timeout: 获取互斥锁超时时间ms
+ * @retval      0，成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取互斥锁超时；1，总线被其他主机占用
+ * @note        获取互斥锁超时时总线仍归其他任务所有，不能改写 bus[lun] 中的任何字段
+ */
+static uint8_t bbus_i2c_xfer_begin(uint8_t lun, uint32_t timeout)
+{
+    if (bbus_i2c_port_mutex_take(lun, timeout))
+    {
+        BBUS_I2C_LOG("[I2C Lock][ERROR]: Bus %d busy\n", lun);
+        return BBUS_I2C_ERR_LOCK_TIMEOUT;
+    }
+#if BBUS_I2C_USE_MULTI_MASTER
+    if (bbus_i2c_wait_idle(lun, timeout))
+    {
+        bbus_i2c_port_mutex_give(lun);
+        return 1; // 总线被其他主机占用
+    }
+#endif
+#if BBUS_I2C_USE_RISE_COMP && BBUS_I2C_RISE_PERIOD
+    if ((bbus_i2c_port_tick_get() - bus[lun].rise_tick) >= BBUS_I2C_RISE_PERIOD)
+    {
+        (void)bbus_i2c_rise_measure(lun); // 失败时保留上一次的补偿值
+    }
+#endif
+    XFER_LOCK(lun);
+    bus[lun].error = BBUS_I2C_ERR_NONE;
+    return 0;
+}
+
+/**
+ * @brief       结束一次传输：与 bbus_i2c_xfer_begin 成对调用，所有退出路径都必须经过此处
+ * @param       lun: I2C总线号
+ * @retval      无
+ */
+static void bbus_i2c_xfer_end(uint8_t lun)
+{
+    XFER_UNLOCK(lun);
+    bbus_i2c_port_mutex_give(lun);
+}
+
+/**
+ * @brief   初始化软件I2C
+ * @param   无
+ * @retval  无
+ */
+void bbus_i2c_init(void)
+{
+    for (uint8_t i = 0; i < BBUS_I2C_BUS_NUM; i++)
+    {
+        bbus_i2c_port_init(i);
+        bus[i].delay_time = 0;
+        bus[i].scl = BBUS_I2C_PIN_UNKNOWN;
+        bus[i].sda = BBUS_I2C_PIN_UNKNOWN;
+        bus[i].sda_out = BBUS_I2C_PIN_UNKNOWN;
+        bus[i].caps = bbus_i2c_port_get_caps(i);
+        bus[i].error = BBUS_I2C_ERR_NONE;
+        bus[i].stretch_timeout = 0;
+#if BBUS_I2C_USE_MULTI_MASTER
+        bus[i].owner = 0;
+        bus[i].busy = 0;
+#endif
+#if BBUS_I2C_USE_STATS
+        bbus_i2c_reset_stats(i);
+#endif
+#if BBUS_I2C_USE_RISE_COMP
+        bus[i].rise_comp = 0;
+        (void)bbus_i2c_rise_measure(i);
+#endif
+    }
+}
+
+#if BBUS_I2C_USE_STATS
+/**
+ * @brief   获取总线统计计数
+ * @param   lun: I2C总线号
+ * @param   stats: 输出的统计数据
+ * @retval  无
+ */
+void bbus_i2c_get_stats(uint8_t lun, bbus_i2c_stats_t *stats)
+{
+    *stats = bus[lun].stats;
+}
+
+/**
+ * @brief   清零总线统计计数
+ * @param   lun: I2C总线号
+ * @retval  无
+ */
+void bbus_i2c_reset_stats(uint8_t lun)
+{
+    bus[lun].stats.port_calls = 0;
+    bus[lun].stats.port_calls_saved = 0;
+    bus[lun].stats.bytes = 0;
+    bus[lun].stats.stretch_events = 0;
+    bus[lun].stats.stretch_timeouts = 0;
+    bus[lun].stats.irq_off_max = 0;
+    bus[lun].stats.arb_lost = 0;
+    bus[lun].stats.busy_waits = 0;
+    bus[lun].stats.foreign_starts = 0;
+    bus[lun].stats.rise_cycles = 0;
+    bus[lun].stats.rise_max = 0;
+    bus[lun].stats.rise_measures = 0;
+    bus[lun].stats.rise_failures = 0;
+}
+#endif
+
+/**
+ * @brief   设置I2C延时时间
+ * @param   lun: I2C总线号
+ * @param   xus: 延时时间 (单位: us)
+ * @retval  无
+ */
+void bbus_i2c_set_delay_time(uint8_t lun, uint32_t xus)
+{
+    bus[lun].delay_time = xus;
+}
+
+/**
+ * @brief   设置时钟延展最长等待时间
+ * @note    端口需支持 BBUS_I2C_PORT_CAP_SCL_READ；每次释放SCL后回读SCL，
+ *          从机拉低SCL时最多等待 xus 微秒，超时记为 BBUS_I2C_ERR_STRETCH_TIMEOUT
+ * @param   lun: I2C总线号
+ * @param   xus: 最长等待时间 (单位: us)，0 表示关闭时钟延展检测
+ * @retval  无
+ */
+void bbus_i2c_set_stretch_timeout(uint8_t lun, uint32_t xus)
+{
+    bus[lun].stretch_timeout = xus;
+}
+
+/**
+ * @brief   获取时钟延展最长等待时间
+ * @param   lun: I2C总线号
+ * @retval  最长等待时间 (单位: us)
+ */
+uint32_t bbus_i2c_get_stretch_timeout(uint8_t lun)
+{
+    return bus[lun].stretch_timeout;
+}
+
+#if BBUS_I2C_USE_PUSH_PULL
+/**
+ * @brief   开启/关闭推挽驱动
+ * @note    推挽时SCL始终由主机驱动；SDA在主机发送时推挽，应答和读数据阶段
+ *          切回开漏/输入，因此核心按非开漏端口处理SDA方向，并且不再回读SCL
+ * @param   lun: I2C总线号
+ * @param   enable: 1：推挽，0：开漏
+ * @retval  0：成功，1：失败
+ */
+uint8_t bbus_i2c_set_push_pull(uint8_t lun, uint8_t enable)
+{
+    uint8_t caps = bbus_i2c_port_get_caps(lun);
+
+    if (!(caps & BBUS_I2C_PORT_CAP_PUSH_PULL))
+    {
+        BBUS_I2C_LOG("[I2C PushPull][ERROR]: Port does not support push-pull\n");
+        return 1;
+    }
+#if BBUS_I2C_USE_MULTI_MASTER
+    if (enable)
+    {
+        BBUS_I2C_LOG("[I2C PushPull][ERROR]: Not allowed on multi-master bus\n");
+        return 1;
+    }
+#endif
+    if (bbus_i2c_lock(lun, BBUS_I2C_WAIT_FOREVER))
+    {
+        return 1;
+    }
+    bbus_i2c_port_set_drive(lun, enable ? 1 : 0);
+    bus[lun].caps = enable ? (caps & ~(BBUS_I2C_PORT_CAP_OPEN_DRAIN | BBUS_I2C_PORT_CAP_SCL_READ)) : caps;
+    /* 引脚模式已改变，下一次访问重新下发电平和方向 */
+    bus[lun].scl = BBUS_I2C_PIN_UNKNOWN;
+    bus[lun].sda = BBUS_I2C_PIN_UNKNOWN;
+    bus[lun].sda_out = BBUS_I2C_PIN_UNKNOWN;
+#if BBUS_I2C_USE_RISE_COMP
+    bus[lun].rise_comp = 0; // 推挽输出无需上升时间补偿，恢复开漏后重新测量
+    if (!enable)
+    {
+        (void)bbus_i2c_rise_measure(lun);
+    }
+#endif
+    bbus_i2c_unlock(lun);
+    return 0;
+}
+#endif
+
+#if BBUS_I2C_USE_RISE_COMP
+/**
+ * @brief   测量SCL上升时间并更新高电平补偿
+ * @note    开启 BBUS_I2C_RISE_PERIOD 时传输开始前也会按间隔自动测量，
+ *          结果记入统计计数 rise_cycles/rise_max/rise_measures/rise_failures
+ * @param   lun: I2C总线号
+ * @param   timeout: 获取总线互斥锁的超时时间ms
+ * @retval  0：成功，1：失败
+ */
+uint8_t bbus_i2c_measure_rise(uint8_t lun, uint32_t timeout)
+{
+    uint8_t ret;
+
+    ret = bbus_i2c_lock(lun, timeout);
+    if (ret)
+    {
+        return ret;
+    }
+    ret = bbus_i2c_rise_measure(lun);
+    bbus_i2c_unlock(lun);
+    return ret;
+}
+
+/**
+ * @brief   获取当前的高电平补偿时间
+ * @param   lun: I2C总线号
+ * @retval  每个SCL高电平额外等待的时间 (单位: us)
+ */
+uint32_t bbus_i2c_get_rise_comp(uint8_t lun)
+{
+    return bus[lun].rise_comp;
+}
+#endif
+
+/**
+ * @brief   获取最近一次传输的错误码
+ * @param   lun: I2C总线号
+ * @retval  BBUS_I2C_ERR_xxx
+ */
+uint8_t bbus_i2c_get_error(uint8_t lun)
+{
+    return bus[lun].error;
+}
+
+/**
+ * @brief   独占总线，用于把多次传输组合成不可被其他任务打断的序列
+ * @note    可递归调用，必须与 bbus_i2c_unlock 成对使用；不同总线的锁互不影响
+ * @param   lun: I2C总线号
+ * @param   timeout: 超时时间ms，BBUS_I2C_WAIT_FOREVER 表示永久等待
+ * @retval  0，成功；BBUS_I2C_ERR_LOCK_TIMEOUT，超时(bbus_i2c_get_error 不更新)
+ */
+uint8_t bbus_i2c_lock(uint8_t lun, uint32_t timeout)
+{
+    if (bbus_i2c_port_mutex_take(lun, timeout))
+    {
+        return BBUS_I2C_ERR_LOCK_TIMEOUT;
+    }
+    return 0;
+}
+
+/**
+ * @brief   释放 bbus_i2c_lock 独占的总线
+ * @param   lun: I2C总线号
+ * @retval  无
+ */
+void bbus_i2c_unlock(uint8_t lun)
+{
+    bbus_i2c_port_mutex_give(lun);
+}
+
+/**
+ * @brief       开始一次事务：获取总线互斥锁、按 BBUS_I2C_LOCK_MODE 关中断并清除错误码
+ * @param       lun: I2C总线号
+ * @param       timeout: 超时时间ms
+ * @retval      0，成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取互斥锁超时；1，总线被其他主机占用
+ */
+uint8_t bbus_i2c_xfer_open(uint8_t lun, uint32_t timeout)
+{
+    return bbus_i2c_xfer_begin(lun, timeout);
+}
+
+/**
+ * @brief       产生(重复)起始信号
+ * @param       lun: I2C总线号
+ * @retval      无
+ */
+void bbus_i2c_xfer_start(uint8_t lun)
+{
+    if (bus[lun].error == BBUS_I2C_ERR_NONE)
+    {
+        bbus_i2c_start_dly(lun, bus[lun].delay_time);
+    }
+}
+
+/**
+ * @brief       发送一个字节并读取应答
+ * @param       lun: I2C总线号
+ * @param       data: 要发送的数据
+ * @param       timeout: 等待ACK超时时间ms
+ * @retval      0，应答；1，未应答或此前已出错
+ */
+uint8_t bbus_i2c_xfer_tx(uint8_t lun, uint8_t data, uint32_t timeout)
+{
+    if (bus[lun].error != BBUS_I2C_ERR_NONE)
+    {
+        return 1;
+    }
+    return bbus_i2c_tx9(lun, data, bus[lun].delay_time, timeout);
+}
+
+/**
+ * @brief       接收一个字节并发送ACK/NACK
+ * @param       lun: I2C总线号
+ * @param       ack: ack=1时，发送ack; ack=0时，发送nack
+ * @retval      接收到的数据，此前已出错时返回0xFF
+ */
+uint8_t bbus_i2c_xfer_rx(uint8_t lun, uint8_t ack)
+{
+    if (bus[lun].error != BBUS_I2C_ERR_NONE)
+    {
+        return 0xFF;
+    }
+    return (uint8_t)bbus_i2c_rx9(lun, ack ? 1 : 0, bus[lun].delay_time);
+}
+
+/**
+ * @brief       结束事务：产生停止信号并释放总线
+ * @param       lun: I2C总线号
+ * @retval      0，事务期间无错误；1，有错误，错误码见 bbus_i2c_get_error
+ */
+uint8_t bbus_i2c_xfer_close(uint8_t lun)
+{
+    bbus_i2c_stop_dly(lun, bus[lun].delay_time);
+    bbus_i2c_xfer_end(lun);
+    return bus[lun].error != BBUS_I2C_ERR_NONE;
+}
+
+#if BBUS_I2C_USE_MULTI_MASTER
+/**
+ * @brief   总线监视：在SDA引脚的双边沿外部中断服务函数中调用，跟踪其他主机的起始/停止信号
+ * @note    SCL为高时SDA下降为起始信号，标记总线忙；SDA上升为停止信号，标记总线空闲。
+ *          本机传输期间产生的边沿被忽略
+ * @param   lun: I2C总线号
+ * @retval  无
+ */
+void bbus_i2c_bus_monitor(uint8_t lun)
+{
+    if (bus[lun].owner || !bbus_i2c_port_scl_get(lun))
+    {
+        return; // 本机传输，或SCL为低时的数据位变化
+    }
+    if (bbus_i2c_port_sda_get(lun))
+    {
+        bus[lun].busy = 0;
+    }
+    else
+    {
+        bus[lun].busy = 1;
+        STAT_ADD(lun, foreign_starts, 1);
+    }
+}
+#endif
+
+/**
+ * @brief   产生I2C起始信号，开始新的一次传输并清除上一次的错误码
+ * @param   lun: I2C总线号
+ * @retval  无
+ */
+void bbus_i2c_start(uint8_t lun)
+{
+    bus[lun].error = BBUS_I2C_ERR_NONE;
+#if BBUS_I2C_USE_MULTI_MASTER
+    if (!bus[lun].owner && bbus_i2c_wait_idle(lun, BBUS_I2C_IDLE_TIMEOUT))
+    {
+        return; // 未取得总线，后续收发均返回失败
+    }
+#endif
+    bbus_i2c_start_dly(lun, bus[lun].delay_time);
+}
+
+/**
+ * @brief       产生I2C停止信号
+ * @param       lun: I2C总线号
+ * @retval      无
+ */
+void bbus_i2c_stop(uint8_t lun)
+{
+    bbus_i2c_stop_dly(lun, bus[lun].delay_time);
+}
+
+/**
+ * @brief       等待应答信号到来
+ * @param       lun: I2C总线号
+ * @param       timeout: 超时时间ms
+ * @retval      1，接收应答失败
+ *              0，接收应答成功
+ */
+uint8_t bbus_i2c_wait_ack(uint8_t lun, uint32_t timeout)
+{
+    uint32_t wait_time = bbus_i2c_port_tick_get();
+
+#if BBUS_I2C_USE_MULTI_MASTER
+    if (!bus[lun].owner)
+    {
+        return 1; // 仲裁失败或未取得总线
+    }
+#endif
+
+    SDA_IN(lun);     /* 设置SDA为输入模式 */
+    SDA_SET(lun, 1); /* 主机释放SDA线(此时外部器件可以拉低SDA线) */
+    DELAY_US(bus[lun].delay_time);
+    SCL_RELEASE(lun); /* SCL=1, 此时从机可以返回ACK */
+    DELAY_US(bus[lun].delay_time);
+    while (SDA_GET(lun)) /* 等待应答 */
+    {
+        if ((bbus_i2c_port_tick_get() - wait_time) >= timeout)
+        {
+            bbus_i2c_stop(lun);
+            return 1;
+        }
+    }
+    SCL_SET(lun, 0); /* SCL=0, 结束ACK检查 */
+    return 0;
+}
+
+/**
+ * @brief       产生ACK应答
+ * @param       lun: I2C总线号
+ * @retval      无
+ */
+void bbus_i2c_ack(uint8_t lun)
+{
+    SCL_SET(lun, 0); /* SCL 0 -> 1 时 SDA = 0,表示应答 */
+    SDA_OUT(lun);
+    DELAY_US(bus[lun].delay_time);
+    SDA_SET(lun, 0); /* SCL 0 -> 1 时 SDA = 0,表示应答 */
+    DELAY_US(bus[lun].delay_time);
+    SCL_RELEASE(lun); /* 产生一个时钟 */
+    DELAY_US(bus[lun].delay_time);
+    SCL_SET(lun, 0);
+}
+
+/**
+ * @brief       不产生ACK应答
+ * @param       lun: I2C总线号
+ * @retval      无
+ */
+void bbus_i2c_nack(uint8_t lun)
+{
+    SCL_SET(lun, 0); /* 产生一个时钟 */
+    SDA_OUT(lun);
+    SDA_SET(lun, 1); /* SCL 0 -> 1  时 SDA = 1,表示不应答 */
+    DELAY_US(bus[lun].delay_time);
+    SCL_RELEASE(lun); /* 产生一个时钟 */
+    DELAY_US(bus[lun].delay_time);
+    SCL_SET(lun, 0);
+}
+
+/**
+ * @brief       I2C发送一个字节
+ * @param       lun: I2C总线号
+ * @param       data: 要发送的数据
+ * @retval      无
+ */
+void bbus_i2c_send_byte(uint8_t lun, const uint8_t data)
+{
+    BYTE_LOCK(lun);
+    SCL_SET(lun, 0);
+    SDA_OUT(lun);
+#if BBUS_I2C_USE_MULTI_MASTER
+    bbus_i2c_kernel_tx8_arb(lun, data, bus[lun].delay_time); // 仲裁失败时由 bbus_i2c_wait_ack 返回失败
+#else
+    bbus_i2c_kernel_tx8(lun, data, bus[lun].delay_time);
+#endif
+    BYTE_UNLOCK(lun);
+    STAT_ADD(lun, bytes, 1);
+}
+
+/**
+ * @brief       I2C读取一个字节
+ * @param       lun: I2C总线号
+ * @param       ack:  ack=1时，发送ack; ack=0时，发送nack
+ * @retval      接收到的数据
+ */
+uint8_t bbus_i2c_read_byte(uint8_t lun, uint8_t ack)
+{
+    return (uint8_t)bbus_i2c_rx9(lun, ack, bus[lun].delay_time);
+}
+
+/* bbus_i2c_check_address 的单次传输，仲裁失败时由外层重试 */
+static uint8_t bbus_i2c_check_address_once(uint8_t lun, uint16_t slave_addr, uint32_t timeout)
+{
+    uint16_t seq[2];
+    uint32_t dly;
+    uint8_t a, ret = 0;
+
+    a = bbus_i2c_addr_seq(seq, slave_addr);
+    ret = bbus_i2c_xfer_begin(lun, timeout);
+    if (ret)
+    {
+        return ret; // 获取总线失败
+    }
+    dly = bus[lun].delay_time;
+
+    if (bbus_i2c_send_seq(lun, seq, a, dly, timeout) < a)
+    {
+        BBUS_I2C_LOG("[I2C Check][ERROR]: Wait ACK failed for address 0x%02X\n", slave_addr);
+        ret = 1; // 接收应答失败
+    }
+
+    bbus_i2c_stop_dly(lun, dly);
+    bbus_i2c_xfer_end(lun);
+    return ret;
+}
+
+/**
+ * @brief       检查从设备地址是否正确
+ * @param       lun: I2C总线号
+ * @param       slave_addr: 从设备地址
+ * @param       timeout: 超时时间ms
+ * @retval      0，读取成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，读取失败
+ */
+uint8_t bbus_i2c_check_address(uint8_t lun, uint16_t slave_addr, uint32_t timeout)
+{
+    ARB_RETRY(lun, bbus_i2c_check_address_once(lun, slave_addr, timeout));
+}
+
+/* bbus_i2c_write_data 的单次传输，仲裁失败时由外层重试 */
+static uint8_t bbus_i2c_write_data_once(uint8_t lun, uint16_t slave_addr, uint8_t reg_address, const uint8_t *data, uint8_t len, uint32_t timeout)
+{
+    // 头部序列: 起始信号 + 从设备地址(写) + 寄存器地址
+    uint16_t seq[3];
+    uint32_t dly;
+    uint8_t a, n, ret = 0;
+
+    a = bbus_i2c_addr_seq(seq, slave_addr);
+    seq[a] = reg_address;
+    ret = bbus_i2c_xfer_begin(lun, timeout);
+    if (ret)
+    {
+        return ret; // 获取总线失败
+    }
+    dly = bus[lun].delay_time;
+
+    n = bbus_i2c_send_seq(lun, seq, a + 1, dly, timeout);
+    if (n < a)
+    {
+        BBUS_I2C_LOG("[I2C Write][ERROR]: Wait ACK failed for address 0x%02X\n", slave_addr);
+        ret = 1; // 接收应答失败
+    }
+    else if (n == a)
+    {
+        BBUS_I2C_LOG("[I2C Write][ERROR]: Wait ACK failed for register 0x%02X\n", reg_address);
+        ret = 1; // 接收应答失败
+    }
+    else
+    {
+        // 发送数据
+        for (uint8_t i = 0; i < len; i++)
+        {
+            if (bbus_i2c_tx9(lun, data[i], dly, timeout))
+            {
+                BBUS_I2C_LOG("[I2C Write][ERROR]: Wait ACK failed for data 0x%02X\n", data[i]);
+                ret = 1; // 接收应答失败
+                break;
+            }
+        }
+    }
+
+    // 产生停止信号
+    bbus_i2c_stop_dly(lun, dly);
+    bbus_i2c_xfer_end(lun);
+
+    return ret;
+}
+
+/**
+ * @brief       软件I2C连续写数据
+ * @param       lun: I2C总线号
+ * @param       salve_adress: 从设备地址
+ * @param       reg_address: 寄存器地址
+ * @param       data: 存储读取数据的缓冲区
+ * @param       len: 要读取的数据长度
+ * @param       timeout: 超时时间ms
+ * @retval      0，读取成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，读取失败
+ */
+uint8_t bbus_i2c_write_data(uint8_t lun, uint16_t slave_addr, uint8_t reg_address, const uint8_t *data, uint8_t len, uint32_t timeout)
+{
+    ARB_RETRY(lun, bbus_i2c_write_data_once(lun, slave_addr, reg_address, data, len, timeout));
+}
+
+/* bbus_i2c_read_data 的单次传输，仲裁失败时由外层重试 */
+static uint8_t bbus_i2c_read_data_once(uint8_t lun, uint16_t slave_addr, uint8_t reg_address, uint8_t *data, uint8_t len, uint32_t timeout)
+{
+    // 头部序列: 起始信号 + 从设备地址(写) + 寄存器地址 + 重复起始信号 + 从设备地址(读)
+    uint16_t seq[4];
+    uint32_t dly;
+    uint8_t a, n, ret = 0;
+
+    a = bbus_i2c_addr_seq(seq, slave_addr);
+    seq[a] = reg_address;
+    seq[a + 1] = bbus_i2c_addr_rd(slave_addr);
+    ret = bbus_i2c_xfer_begin(lun, timeout);
+    if (ret)
+    {
+        return ret; // 获取总线失败
+    }
+    dly = bus[lun].delay_time;
+
+    n = bbus_i2c_send_seq(lun, seq, a + 2, dly, timeout);
+    if (n < a)
+    {
+        BBUS_I2C_LOG("[I2C Read][ERROR]: Wait ACK failed for address 0x%02X\n", slave_addr);
+        ret = 1; // 接收应答失败
+    }
+    else if (n == a)
+    {
+        BBUS_I2C_LOG("[I2C Read][ERROR]: Wait ACK failed for register 0x%02X\n", reg_address);
+        ret = 1; // 接收应答失败
+    }
+    else if (n == a + 1)
+    {
+        BBUS_I2C_LOG("[I2C Read][ERROR]: Wait ACK failed for address 0x%02X in read mode\n", slave_addr);
+        ret = 1; // 接收应答失败
+    }
+    else
+    {
+        // 读取数据
+        bbus_i2c_recv_stream(lun, data, len, dly);
+        if (bus[lun].error != BBUS_I2C_ERR_NONE)
+        {
+            BBUS_I2C_LOG("[I2C Read][ERROR]: Clock stretch timeout for address 0x%02X\n", slave_addr);
+            ret = 1; // 时钟延展超时，数据无效
+        }
+    }
+
+    // 产生停止信号
+    bbus_i2c_stop_dly(lun, dly);
+    bbus_i2c_xfer_end(lun);
+
+    return ret;
+}
+
+/**
+ * @brief       软件I2C连续读数据
+ * @param       lun: I2C总线号
+ * @param       salve_adress: 从设备地址
+ * @param       reg_address: 寄存器地址
+ * @param       data: 存储读取数据的缓冲区
+ * @param       len: 要读取的数据长度
+ * @param       timeout: 超时时间ms
+ * @retval      0，读取成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，读取失败
+ */
+uint8_t bbus_i2c_read_data(uint8_t lun, uint16_t slave_addr, uint8_t reg_address, uint8_t *data, uint8_t len, uint32_t timeout)
+{
+    ARB_RETRY(lun, bbus_i2c_read_data_once(lun, slave_addr, reg_address, data, len, timeout));
+}
+
+/* bbus_i2c_read_seq 的单次传输，仲裁失败时由外层重试 */
+static uint8_t bbus_i2c_read_seq_once(uint8_t lun, uint16_t slave_addr, uint8_t *data, uint8_t len, uint32_t timeout)
+{
+    // 头部序列: 起始信号 + 从设备地址(读)；10位地址需先发送地址(写)再以重复起始信号切换为读
+    uint16_t seq[3];
+    uint32_t dly;
+    uint8_t n = 0, ret = 0;
+
+    if (slave_addr & BBUS_I2C_ADDR_10BIT)
+    {
+        n = bbus_i2c_addr_seq(seq, slave_addr);
+    }
+    seq[n++] = bbus_i2c_addr_rd(slave_addr);
+    ret = bbus_i2c_xfer_begin(lun, timeout);
+    if (ret)
+    {
+        return ret; // 获取总线失败
+    }
+    dly = bus[lun].delay_time;
+
+    if (bbus_i2c_send_seq(lun, seq, n, dly, timeout) < n)
+    {
+        BBUS_I2C_LOG("[I2C Read][ERROR]: Wait ACK failed for address 0x%02X in read mode\n", slave_addr);
+        ret = 1; // 接收应答失败
+    }
+    else
+    {
+        // 读取数据
+        bbus_i2c_recv_stream(lun, data, len, dly);
+        if (bus[lun].error != BBUS_I2C_ERR_NONE)
+        {
+            BBUS_I2C_LOG("[I2C Read][ERROR]: Clock stretch timeout for address 0x%02X\n", slave_addr);
+            ret = 1; // 时钟延展超时，数据无效
+        }
+    }
+
+    // 产生停止信号
+    bbus_i2c_stop_dly(lun, dly);
+    bbus_i2c_xfer_end(lun);
+
+    return ret;
+}
+
+/**
+ * @brief       直接读 N 字节序列（无寄存器地址阶段）
+ * @param       lun: I2C总线号
+ * @param       salve_adress: 从设备地址
+ * @param       data: 存储读取数据的缓冲区
+ * @param       len: 要读取的数据长度
+ * @param       timeout: 超时时间ms
+ * @retval      0，读取成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，读取失败
+ */
+uint8_t bbus_i2c_read_seq(uint8_t lun, uint16_t slave_addr, uint8_t *data, uint8_t len, uint32_t timeout)
+{
+    ARB_RETRY(lun, bbus_i2c_read_seq_once(lun, slave_addr, data, len, timeout));
+}
+
+/**
+ * @brief       生成寄存器访问的头部序列：起始信号 + 从设备地址(写) + 寄存器地址(高字节在前)
+ * @param       seq: 头部序列缓冲区，至少5个元素
+ * @param       slave_addr: 从设备地址
+ * @param       reg_address: 寄存器地址
+ * @param       reg_width: 寄存器地址宽度(字节)，0~2
+ * @retval      序列长度
+ */
+static uint8_t bbus_i2c_reg_seq(uint16_t *seq, uint16_t slave_addr, uint16_t reg_address, uint8_t reg_width)
+{
+    uint8_t n = bbus_i2c_addr_seq(seq, slave_addr);
+
+    if (reg_width >= 2)
+    {
+        seq[n++] = (reg_address >> 8) & 0xFF;
+    }
+    if (reg_width >= 1)
+    {
+        seq[n++] = reg_address & 0xFF;
+    }
+    return n;
+}
+
+/* bbus_i2c_write_reg 的单次传输，仲裁失败时由外层重试 */
+static uint8_t bbus_i2c_write_reg_once(uint8_t lun, uint16_t slave_addr, uint16_t reg_address, uint8_t reg_width, const uint8_t *data, uint8_t len, uint32_t timeout)
+{
+    uint16_t seq[5];
+    uint32_t dly;
+    uint8_t n, sent, ret = 0;
+
+    n = bbus_i2c_reg_seq(seq, slave_addr, reg_address, reg_width);
+    ret = bbus_i2c_xfer_begin(lun, timeout);
+    if (ret)
+    {
+        return ret; // 获取总线失败
+    }
+    dly = bus[lun].delay_time;
+
+    sent = bbus_i2c_send_seq(lun, seq, n, dly, timeout);
+    if (sent < ((slave_addr & BBUS_I2C_ADDR_10BIT) ? 2 : 1))
+    {
+        BBUS_I2C_LOG("[I2C Write][ERROR]: Wait ACK failed for address 0x%02X\n", slave_addr);
+        ret = 1; // 接收应答失败
+    }
+    else if (sent < n)
+    {
+        BBUS_I2C_LOG("[I2C Write][ERROR]: Wait ACK failed for register 0x%04X\n", reg_address);
+        ret = 1; // 接收应答失败
+    }
+    else
+    {
+        // 发送数据
+        for (uint8_t i = 0; i < len; i++)
+        {
+            if (bbus_i2c_tx9(lun, data[i], dly, timeout))
+            {
+                BBUS_I2C_LOG("[I2C Write][ERROR]: Wait ACK failed for data 0x%02X\n", data[i]);
+                ret = 1; // 接收应答失败
+                break;
+            }
+        }
+    }
+
+    // 产生停止信号
+    bbus_i2c_stop_dly(lun, dly);
+    bbus_i2c_xfer_end(lun);
+
+    return ret;
+}
+
+/**
+ * @brief       软件I2C连续写数据(可变宽度寄存器地址)
+ * @param       lun: I2C总线号
+ * @param       slave_addr: 从设备地址
+ * @param       reg_address: 寄存器地址
+ * @param       reg_width: 寄存器地址宽度(字节)，0：无寄存器地址，1：8位，2：16位(高字节在前)
+ * @param       data: 要写入的数据
+ * @param       len: 要写入的数据长度
+ * @param       timeout: 超时时间ms
+ * @retval      0，写入成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，写入失败
+ */
+uint8_t bbus_i2c_write_reg(uint8_t lun, uint16_t slave_addr, uint16_t reg_address, uint8_t reg_width, const uint8_t *data, uint8_t len, uint32_t timeout)
+{
+    ARB_RETRY(lun, bbus_i2c_write_reg_once(lun, slave_addr, reg_address, reg_width, data, len, timeout));
+}
+
+/* bbus_i2c_read_reg 的单次传输，仲裁失败时由外层重试 */
+static uint8_t bbus_i2c_read_reg_once(uint8_t lun, uint16_t slave_addr, uint16_t reg_address, uint8_t reg_width, uint8_t *data, uint8_t len, uint32_t timeout)
+{
+    uint16_t seq[6];
+    uint32_t dly;
+    uint8_t n = 0, ret = 0;
+
+    // 头部序列: [起始信号 + 从设备地址(写) + 寄存器地址] + 重复起始信号 + 从设备地址(读)
+    if (reg_width > 0 || (slave_addr & BBUS_I2C_ADDR_10BIT))
+    {
+        n = bbus_i2c_reg_seq(seq, slave_addr, reg_address, reg_width);
+    }
+    seq[n++] = bbus_i2c_addr_rd(slave_addr);
+
+    ret = bbus_i2c_xfer_begin(lun, timeout);
+    if (ret)
+    {
+        return ret; // 获取总线失败
+    }
+    dly = bus[lun].delay_time;
+
+    if (bbus_i2c_send_seq(lun, seq, n, dly, timeout) < n)
+    {
+        BBUS_I2C_LOG("[I2C Read][ERROR]: Wait ACK failed for address 0x%02X register 0x%04X\n", slave_addr, reg_address);
+        ret = 1; // 接收应答失败
+    }
+    else
+    {
+        // 读取数据
+        bbus_i2c_recv_stream(lun, data, len, dly);
+        if (bus[lun].error != BBUS_I2C_ERR_NONE)
+        {
+            BBUS_I2C_LOG("[I2C Read][ERROR]: Clock stretch timeout for address 0x%02X\n", slave_addr);
+            ret = 1; // 时钟延展超时，数据无效
+        }
+    }
+
+    // 产生停止信号
+    bbus_i2c_stop_dly(lun, dly);
+    bbus_i2c_xfer_end(lun);
+
+    return ret;
+}
+
+/**
+ * @brief       软件I2C连续读数据(可变宽度寄存器地址)
+ * @param       lun: I2C总线号
+ * @param       slave_addr: 从设备地址
+ * @param       reg_address: 寄存器地址
+ * @param       reg_width: 寄存器地址宽度(字节)，0：无寄存器地址(等同 bbus_i2c_read_seq)，1：8位，2：16位(高字节在前)
+ * @param       data: 存储读取数据的缓冲区
+ * @param       len: 要读取的数据长度
+ * @param       timeout: 超时时间ms
+ * @retval      0，读取成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，读取失败
+ */
+uint8_t bbus_i2c_read_reg(uint8_t lun, uint16_t slave_addr, uint16_t reg_address, uint8_t reg_width, uint8_t *data, uint8_t len, uint32_t timeout)
+{
+    ARB_RETRY(lun, bbus_i2c_read_reg_once(lun, slave_addr, reg_address, reg_width, data, len, timeout));
+}
+
+/* 多总线同步写：所有选中的总线共用同一时序，逐个时钟沿同时驱动 */
+#if (BBUS_I2C_BUS_NUM > 32)
+#error "bbus_i2c_broadcast_write: lun mask is 32 bits, BBUS_I2C_BUS_NUM must not exceed 32"
+#endif
+
+#define LUN_MASK_ALL ((BBUS_I2C_BUS_NUM >= 32) ? 0xFFFFFFFFu : ((1u << BBUS_I2C_BUS_NUM) - 1u))
+#define FOR_EACH_LUN(lun, mask) \
+    for (uint8_t lun = 0; lun < BBUS_I2C_BUS_NUM; lun++) if ((mask) & (1u << lun))
+
+static void bbus_i2c_mask_scl(uint32_t mask, uint8_t level)
+{
+#if BBUS_I2C_USE_PORT_MASK
+    bbus_i2c_port_scl_set_mask(mask, level);
+    FOR_EACH_LUN(lun, mask)
+    {
+        bus[lun].scl = level;
+    }
+#else
+    FOR_EACH_LUN(lun, mask)
+    {
+        SCL_SET(lun, level);
+    }
+#endif
+}
+
+static void bbus_i2c_mask_sda(uint32_t mask, uint8_t level)
+{
+#if BBUS_I2C_USE_PORT_MASK
+    bbus_i2c_port_sda_set_mask(mask, level);
+    FOR_EACH_LUN(lun, mask)
+    {
+        bus[lun].sda = level;
+    }
+#else
+    FOR_EACH_LUN(lun, mask)
+    {
+        SDA_SET(lun, level);
+    }
+#endif
+}
+
+static uint32_t bbus_i2c_mask_sda_get(uint32_t mask)
+{
+#if BBUS_I2C_USE_PORT_MASK
+    return bbus_i2c_port_sda_get_mask(mask);
+#else
+    uint32_t levels = 0;
+
+    FOR_EACH_LUN(lun, mask)
+    {
+        if (SDA_GET(lun))
+        {
+            levels |= 1u << lun;
+        }
+    }
+    return levels;
+#endif
+}
+
+/* 返回时钟延展超时的总线掩码 */
+static uint32_t bbus_i2c_mask_scl_release(uint32_t mask)
+{
+    uint32_t stuck = 0;
+
+    bbus_i2c_mask_scl(mask, 1);
+    FOR_EACH_LUN(lun, mask)
+    {
+        if (bbus_i2c_scl_sync(lun))
+        {
+            stuck |= 1u << lun;
+        }
+    }
+    return stuck;
+}
+
+static void bbus_i2c_mask_start(uint32_t mask, uint32_t dly)
+{
+    FOR_EACH_LUN(lun, mask)
+    {
+        SDA_OUT(lun);
+    }
+    bbus_i2c_mask_sda(mask, 1);
+    bbus_i2c_mask_scl_release(mask);
+    DELAY_US(dly);
+    bbus_i2c_mask_sda(mask, 0); /* START信号: 当SCL为高时, SDA从高变成低, 表示起始信号 */
+    DELAY_US(dly);
+    bbus_i2c_mask_scl(mask, 0); /* 钳住I2C总线，准备发送数据 */
+}
+
+static void bbus_i2c_mask_stop(uint32_t mask, uint32_t dly)
+{
+    FOR_EACH_LUN(lun, mask)
+    {
+        SDA_OUT(lun);
+    }
+    bbus_i2c_mask_sda(mask, 0);
+    bbus_i2c_mask_scl(mask, 0);
+    DELAY_US(dly);
+    bbus_i2c_mask_scl_release(mask);
+    bbus_i2c_mask_sda(mask, 1); /* STOP信号: 当SCL为高时, SDA从低变成高, 表示停止信号 */
+    DELAY_US(dly);
+}
+
+/**
+ * @brief       在多条总线上同时发送一个字节并读取各自的ACK位
+ * @param       mask: 总线掩码
+ * @param       data: 要发送的数据
+ * @param       dly: 半周期延时(us)
+ * @param       timeout: 等待ACK超时时间ms
+ * @retval      未应答(或时钟延展超时)的总线掩码
+ */
+static uint32_t bbus_i2c_mask_tx9(uint32_t mask, uint8_t data, uint32_t dly, uint32_t timeout)
+{
+    uint32_t nack, live = mask;
+
+    FOR_EACH_LUN(lun, mask)
+    {
+        BYTE_LOCK(lun);
+        SDA_OUT(lun);
+        STAT_ADD(lun, bytes, 1);
+    }
+    /* 时钟延展超时的总线立即退出，其余总线继续 */
+    for (int8_t n = 7; n >= 0 && live; n--)
+    {
+        bbus_i2c_mask_sda(live, (uint8_t)((data >> n) & 1u));
+        DELAY_US(dly);
+        live &= ~bbus_i2c_mask_scl_release(live);
+        DELAY_US(dly);
+        bbus_i2c_mask_scl(live, 0);
+    }
+
+    /* 第9个时钟：释放SDA，由各总线上的从机分别拉低表示应答 */
+    FOR_EACH_LUN(lun, live)
+    {
+        SDA_IN(lun);
+    }
+    bbus_i2c_mask_sda(live, 1);
+    DELAY_US(dly);
+    live &= ~bbus_i2c_mask_scl_release(live);
+    DELAY_US(dly);
+    nack = bbus_i2c_mask_sda_get(live);
+    FOR_EACH_LUN(lun, mask)
+    {
+        BYTE_UNLOCK(lun);
+    }
+
+    /* 慢速路径：只对尚未应答的总线继续等待，SCL保持高电平，期间临时开中断 */
+    if (nack)
+    {
+        uint32_t wait_time = bbus_i2c_port_tick_get();
+
+        FOR_EACH_LUN(lun, mask)
+        {
+            SLOW_UNLOCK(lun);
+        }
+        while (nack)
+        {
+            if ((bbus_i2c_port_tick_get() - wait_time) >= timeout)
+            {
+                break;
+            }
+            nack = bbus_i2c_mask_sda_get(nack);
+        }
+        FOR_EACH_LUN(lun, mask)
+        {
+            SLOW_LOCK(lun);
+        }
+    }
+    bbus_i2c_mask_scl(live, 0);
+
+    FOR_EACH_LUN(lun, mask)
+    {
+        if (nack & (1u << lun))
+        {
+            bus[lun].error = BBUS_I2C_ERR_NACK;
+        }
+        else if (bus[lun].error != BBUS_I2C_ERR_NONE)
+        {
+            nack |= 1u << lun;
+        }
+    }
+    return nack;
+}
+
+/**
+ * @brief       同时获取多条总线：先按总线号顺序获取全部互斥锁，再关中断
+ * @param       mask: 总线掩码
+ * @param       timeout: 获取互斥锁超时时间ms
+ * @retval      0，成功；BBUS_I2C_ERR_LOCK_TIMEOUT，任一总线获取超时(已获取的锁全部释放)
+ */
+static uint8_t bbus_i2c_mask_begin(uint32_t mask, uint32_t timeout)
+{
+    uint32_t taken = 0;
+
+    FOR_EACH_LUN(lun, mask)
+    {
+        if (bbus_i2c_port_mutex_take(lun, timeout))
+        {
+            BBUS_I2C_LOG("[I2C Lock][ERROR]: Bus %d busy\n", lun);
+            FOR_EACH_LUN(i, taken)
+            {
+                bbus_i2c_port_mutex_give(i);
+            }
+            return BBUS_I2C_ERR_LOCK_TIMEOUT;
+        }
+        taken |= 1u << lun;
+    }
+    FOR_EACH_LUN(lun, mask)
+    {
+        XFER_LOCK(lun);
+        bus[lun].error = BBUS_I2C_ERR_NONE;
+    }
+    return 0;
+}
+
+static void bbus_i2c_mask_end(uint32_t mask)
+{
+    FOR_EACH_LUN(lun, mask)
+    {
+        XFER_UNLOCK(lun);
+        bbus_i2c_port_mutex_give(lun);
+    }
+}
+
+/**
+ * @brief       多总线同步写：在多条总线上同时向相同地址的设备写入相同数据
+ * @param       lun_mask: 总线掩码，第n位对应总线n
+ * @param       slave_addr: 从设备地址
+ * @param       reg_address: 寄存器地址
+ * @param       data: 要写入的数据
+ * @param       len: 要写入的数据长度
+ * @param       ack_mask: 返回全部字节均应答(写入成功)的总线掩码，不需要时传NULL
+ * @param       timeout: 超时时间ms
+ * @retval      0，全部总线写入成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，至少一条总线失败
+ */
+uint8_t bbus_i2c_broadcast_write(uint32_t lun_mask, uint16_t slave_addr, uint8_t reg_address, const uint8_t *data, uint8_t len, uint32_t *ack_mask, uint32_t timeout)
+{
+    uint32_t active, dly = 0;
+    uint16_t seq[2];
+    uint8_t a = bbus_i2c_addr_seq(seq, slave_addr), ret;
+
+    lun_mask &= LUN_MASK_ALL;
+    if (ack_mask)
+    {
+        *ack_mask = 0;
+    }
+    if (lun_mask == 0)
+    {
+        return 1;
+    }
+    ret = bbus_i2c_mask_begin(lun_mask, timeout);
+    if (ret)
+    {
+        return ret; // 获取总线失败
+    }
+    FOR_EACH_LUN(lun, lun_mask)
+    {
+        if (bus[lun].delay_time > dly)
+        {
+            dly = bus[lun].delay_time; // 按最慢的总线确定时序
+        }
+    }
+
+    // 头部: 起始信号 + 从设备地址(写) + 寄存器地址，未应答的总线退出后续字节
+    active = lun_mask;
+    bbus_i2c_mask_start(active, dly);
+    for (uint8_t i = 0; i < a && active; i++)
+    {
+        active &= ~bbus_i2c_mask_tx9(active, (uint8_t)seq[i], dly, timeout);
+    }
+    if (active)
+    {
+        active &= ~bbus_i2c_mask_tx9(active, reg_address, dly, timeout);
+    }
+    for (uint8_t i = 0; i < len && active; i++)
+    {
+        active &= ~bbus_i2c_mask_tx9(active, data[i], dly, timeout);
+    }
+
+    // 所有总线统一产生停止信号
+    bbus_i2c_mask_stop(lun_mask, dly);
+    bbus_i2c_mask_end(lun_mask);
+
+    if (active != lun_mask)
+    {
+        BBUS_I2C_LOG("[I2C Broadcast][ERROR]: Wait ACK failed on bus mask 0x%08lX\n", (unsigned long)(lun_mask & ~active));
+    }
+    if (ack_mask)
+    {
+        *ack_mask = active;
+    }
+    return active != lun_mask;
+}
+
+/**
+ * @brief       获取总线半周期延时
+ * @param       lun: I2C总线号
+ * @retval      延时时间 (单位: us)
+ */
+uint32_t bbus_i2c_get_delay_time(uint8_t lun)
+{
+    return bus[lun].delay_time;
+}
+
+/**
+ * @brief       设置SCL电平
+ * @param       lun: I2C总线号
+ * @param       level: 1：释放(高电平)，0：拉低
+ * @retval      无
+ */
+void bbus_i2c_line_scl(uint8_t lun, uint8_t level)
+{
+    SCL_SET(lun, level);
+}
+
+/**
+ * @brief       读取SCL电平，端口不支持 BBUS_I2C_PORT_CAP_SCL_READ 时返回最近一次驱动的电平
+ * @param       lun: I2C总线号
+ * @retval      SCL电平
+ */
+uint8_t bbus_i2c_line_scl_get(uint8_t lun)
+{
+    if (bus[lun].caps & BBUS_I2C_PORT_CAP_SCL_READ)
+    {
+        return bbus_i2c_port_scl_get(lun);
+    }
+    return bus[lun].scl;
+}
+
+/**
+ * @brief       由主机驱动SDA电平
+ * @param       lun: I2C总线号
+ * @param       level: 1：高电平，0：低电平
+ * @retval      无
+ */
+void bbus_i2c_line_sda(uint8_t lun, uint8_t level)
+{
+    SDA_OUT(lun);
+    SDA_SET(lun, level);
+}
+
+/**
+ * @brief       释放SDA，交由从机驱动
+ * @param       lun: I2C总线号
+ * @retval      无
+ */
+void bbus_i2c_line_sda_release(uint8_t lun)
+{
+    SDA_IN(lun);
+    SDA_SET(lun, 1);
+}
+
+/**
+ * @brief       读取SDA电平
+ * @param       lun: I2C总线号
+ * @retval      SDA电平
+ */
+uint8_t bbus_i2c_line_sda_get(uint8_t lun)
+{
+    return SDA_GET(lun);
 }
@@ -33,6 +33,38 @@
 #include "bbus_i2c_port.h"
 #include <stdint.h>
 
+/* 错误码，由 bbus_i2c_get_error 返回 */
+#define BBUS_I2C_ERR_NONE            0 // 无错误
+#define BBUS_I2C_ERR_NACK            1 // 从机未应答
+#define BBUS_I2C_ERR_STRETCH_TIMEOUT 2 // 从机拉低SCL(时钟延展)超时
+#define BBUS_I2C_ERR_LOCK_TIMEOUT    3 // 获取总线互斥锁超时：此时总线归其他任务所有，传输函数直接返回该值，不更新 bbus_i2c_get_error
+#define BBUS_I2C_ERR_ARB_LOST        4 // 多主机仲裁失败(重试次数用尽)
+#define BBUS_I2C_ERR_BUS_BUSY        5 // 等待其他主机释放总线超时
+
+#define BBUS_I2C_LUN(lun) (1u << (lun)) // 总线号转换为总线掩码位，用于 bbus_i2c_broadcast_write
+
+/* 从设备地址：7位地址使用左移后的8位形式(如0xA0)；10位地址为 BBUS_I2C_ADDR_10BIT | 地址(0~0x3FF，不移位) */
+#define BBUS_I2C_ADDR_10BIT       0x8000u
+#define BBUS_I2C_ADDR10(addr)     (BBUS_I2C_ADDR_10BIT | ((addr) & 0x3FFu))
+
+/* 总线统计计数，用于评估每字节的端口调用开销 */
+typedef struct
+{
+    uint32_t port_calls;       /* 实际调用端口层引脚函数的次数 */
+    uint32_t port_calls_saved; /* 因电平/方向未变化而省略的端口调用次数 */
+    uint32_t bytes;            /* 已发送/接收的字节数 */
+    uint32_t stretch_events;   /* 检测到从机时钟延展的次数 */
+    uint32_t stretch_timeouts; /* 时钟延展等待超时的次数 */
+    uint32_t irq_off_max;      /* 单次关中断窗口的最大长度，单位为 bbus_i2c_port_cycle_get 的计数 */
+    uint32_t arb_lost;         /* 仲裁失败的次数(多主机) */
+    uint32_t busy_waits;       /* 起始信号前等待其他主机释放总线的次数(多主机) */
+    uint32_t foreign_starts;   /* bbus_i2c_bus_monitor 检测到的其他主机起始信号次数(多主机) */
+    uint32_t rise_cycles;      /* 最近一次测得的SCL上升时间，单位为 bbus_i2c_port_cycle_get 的计数 */
+    uint32_t rise_max;         /* 测得的最大SCL上升时间，单位同上 */
+    uint32_t rise_measures;    /* 上升时间测量成功的次数 */
+    uint32_t rise_failures;    /* 上升时间测量失败(SCL被拉住或超过 BBUS_I2C_RISE_MAX_US)的次数 */
+} bbus_i2c_stats_t;
+
 /**
  * @brief   初始化软件I2C
  * @param   无
@@ -48,8 +80,105 @@ void bbus_i2c_init(void);
  */
 void bbus_i2c_set_delay_time(uint8_t lun, uint32_t xus);
 
+#if BBUS_I2C_USE_STATS
+/**
+ * @brief   获取总线统计计数
+ * @param   lun: I2C总线号
+ * @param   stats: 输出的统计数据
+ * @retval  无
+ */
+void bbus_i2c_get_stats(uint8_t lun, bbus_i2c_stats_t *stats);
+
+/**
+ * @brief   清零总线统计计数
+ * @param   lun: I2C总线号
+ * @retval  无
+ */
+void bbus_i2c_reset_stats(uint8_t lun);
+#endif
+
+/**
+ * @brief   设置时钟延展最长等待时间
+ * @note    端口需支持 BBUS_I2C_PORT_CAP_SCL_READ
+ * @param   lun: I2C总线号
+ * @param   xus: 最长等待时间 (单位: us)，0 表示关闭时钟延展检测
+ * @retval  无
+ */
+void bbus_i2c_set_stretch_timeout(uint8_t lun, uint32_t xus);
+
+/**
+ * @brief   获取时钟延展最长等待时间
+ * @param   lun: I2C总线号
+ * @retval  最长等待时间 (单位: us)
+ */
+uint32_t bbus_i2c_get_stretch_timeout(uint8_t lun);
+
+#if BBUS_I2C_USE_PUSH_PULL
+/**
+ * @brief   开启/关闭推挽驱动
+ * @note    端口需支持 BBUS_I2C_PORT_CAP_PUSH_PULL；仅用于单主机且从机不做时钟延展的总线，
+ *          推挽时不回读SCL，时钟延展检测失效
+ * @param   lun: I2C总线号
+ * @param   enable: 1：推挽，0：开漏
+ * @retval  0：成功，1：失败
+ */
+uint8_t bbus_i2c_set_push_pull(uint8_t lun, uint8_t enable);
+#endif
+
+#if BBUS_I2C_USE_RISE_COMP
+/**
+ * @brief   测量SCL上升时间并更新高电平补偿
+ * @note    端口需支持 BBUS_I2C_PORT_CAP_SCL_READ，应在总线空闲时调用
+ * @param   lun: I2C总线号
+ * @param   timeout: 获取总线互斥锁的超时时间ms
+ * @retval  0：成功，1：失败
+ */
+uint8_t bbus_i2c_measure_rise(uint8_t lun, uint32_t timeout);
+
 /**
- * @brief   产生I2C起始信号
+ * @brief   获取当前的高电平补偿时间
+ * @param   lun: I2C总线号
+ * @retval  每个SCL高电平额外等待的时间 (单位: us)
+ */
+uint32_t bbus_i2c_get_rise_comp(uint8_t lun);
+#endif
+
+/**
+ * @brief   获取最近一次传输的错误码
+ * @param   lun: I2C总线号
+ * @retval  BBUS_I2C_ERR_xxx
+ */
+uint8_t bbus_i2c_get_error(uint8_t lun);
+
+#if BBUS_I2C_USE_MULTI_MASTER
+/**
+ * @brief   总线监视：在SDA引脚的双边沿外部中断服务函数中调用，跟踪其他主机的起始/停止信号
+ * @note    SCL为高时SDA下降为起始信号，标记总线忙；SDA上升为停止信号，标记总线空闲。
+ *          本机传输期间产生的边沿被忽略
+ * @param   lun: I2C总线号
+ * @retval  无
+ */
+void bbus_i2c_bus_monitor(uint8_t lun);
+#endif
+
+/**
+ * @brief   独占总线，用于把多次传输组合成不可被其他任务打断的序列
+ * @note    可递归调用，必须与 bbus_i2c_unlock 成对使用；不同总线的锁互不影响
+ * @param   lun: I2C总线号
+ * @param   timeout: 超时时间ms，BBUS_I2C_WAIT_FOREVER 表示永久等待
+ * @retval  0，成功；BBUS_I2C_ERR_LOCK_TIMEOUT，超时(bbus_i2c_get_error 不更新)
+ */
+uint8_t bbus_i2c_lock(uint8_t lun, uint32_t timeout);
+
+/**
+ * @brief   释放 bbus_i2c_lock 独占的总线
+ * @param   lun: I2C总线号
+ * @retval  无
+ */
+void bbus_i2c_unlock(uint8_t lun);
+
+/**
+ * @brief   产生I2C起始信号，开始新的一次传输并清除上一次的错误码
  * @param   lun: I2C总线号
  * @retval  无
  */
@@ -105,9 +234,9 @@ uint8_t bbus_i2c_read_byte(uint8_t lun, uint8_t ack);
  * @param       lun: I2C总线号
  * @param       slave_addr: 从设备地址
  * @param       timeout: 超时时间ms
- * @retval      0，读取成功；1，读取失败
+ * @retval      0，读取成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，读取失败
  */
-uint8_t bbus_i2c_check_address(uint8_t lun, uint8_t slave_addr, uint32_t timeout);
+uint8_t bbus_i2c_check_address(uint8_t lun, uint16_t slave_addr, uint32_t timeout);
 
 /**
  * @brief       软件I2C连续写数据
@@ -117,9 +246,9 @@ uint8_t bbus_i2c_check_address(uint8_t lun, uint8_t slave_addr, uint32_t timeout
  * @param       data: 存储读取数据的缓冲区
  * @param       len: 要读取的数据长度
  * @param       timeout: 超时时间ms
- * @retval      0，读取成功；1，读取失败
+ * @retval      0，读取成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，读取失败
  */
-uint8_t bbus_i2c_write_data(uint8_t lun, uint8_t slave_addr, uint8_t reg_address, const uint8_t *data, uint8_t len, uint32_t timeout);
+uint8_t bbus_i2c_write_data(uint8_t lun, uint16_t slave_addr, uint8_t reg_address, const uint8_t *data, uint8_t len, uint32_t timeout);
 
 /**
  * @brief       软件I2C连续读数据
@@ -129,9 +258,9 @@ uint8_t bbus_i2c_write_data(uint8_t lun, uint8_t slave_addr, uint8_t reg_address
  * @param       data: 存储读取数据的缓冲区
  * @param       len: 要读取的数据长度
  * @param       timeout: 超时时间ms
- * @retval      0，读取成功；1，读取失败
+ * @retval      0，读取成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，读取失败
  */
-uint8_t bbus_i2c_read_data(uint8_t lun, uint8_t slave_addr, uint8_t reg_address, uint8_t *data, uint8_t len, uint32_t timeout);
+uint8_t bbus_i2c_read_data(uint8_t lun, uint16_t slave_addr, uint8_t reg_address, uint8_t *data, uint8_t len, uint32_t timeout);
 
 /**
  * @brief       直接读 N 字节序列（无寄存器地址阶段）
@@ -140,8 +269,138 @@ uint8_t bbus_i2c_read_data(uint8_t lun, uint8_t slave_addr, uint8_t reg_address,
  * @param       data: 存储读取数据的缓冲区
  * @param       len: 要读取的数据长度
  * @param       timeout: 超时时间ms
- * @retval      0，读取成功；1，读取失败
+ * @retval      0，读取成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，读取失败
+ */
+uint8_t bbus_i2c_read_seq(uint8_t lun, uint16_t slave_addr, uint8_t *data, uint8_t len, uint32_t timeout);
+
+/**
+ * @brief       软件I2C连续写数据(可变宽度寄存器地址)
+ * @param       lun: I2C总线号
+ * @param       slave_addr: 从设备地址
+ * @param       reg_address: 寄存器地址
+ * @param       reg_width: 寄存器地址宽度(字节)，0：无寄存器地址，1：8位，2：16位(高字节在前)
+ * @param       data: 要写入的数据
+ * @param       len: 要写入的数据长度
+ * @param       timeout: 超时时间ms
+ * @retval      0，写入成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，写入失败
+ */
+uint8_t bbus_i2c_write_reg(uint8_t lun, uint16_t slave_addr, uint16_t reg_address, uint8_t reg_width, const uint8_t *data, uint8_t len, uint32_t timeout);
+
+/**
+ * @brief       软件I2C连续读数据(可变宽度寄存器地址)
+ * @param       lun: I2C总线号
+ * @param       slave_addr: 从设备地址
+ * @param       reg_address: 寄存器地址
+ * @param       reg_width: 寄存器地址宽度(字节)，0：无寄存器地址(等同 bbus_i2c_read_seq)，1：8位，2：16位(高字节在前)
+ * @param       data: 存储读取数据的缓冲区
+ * @param       len: 要读取的数据长度
+ * @param       timeout: 超时时间ms
+ * @retval      0，读取成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，读取失败
+ */
+uint8_t bbus_i2c_read_reg(uint8_t lun, uint16_t slave_addr, uint16_t reg_address, uint8_t reg_width, uint8_t *data, uint8_t len, uint32_t timeout);
+
+/**
+ * @brief       多总线同步写：在多条总线上同时向相同地址的设备写入相同数据
+ * @note        选中的总线共用同一时序(取其中最大的半周期延时)，每个时钟沿同时驱动；
+ *              各总线的ACK独立采样，未应答的总线退出后续字节，最后统一产生停止信号。
+ *              端口开启 BBUS_I2C_USE_PORT_MASK 时，同一GPIO端口上的引脚一次写入
+ * @param       lun_mask: 总线掩码，第n位对应总线n，可用 BBUS_I2C_LUN(n) 组合
+ * @param       slave_addr: 从设备地址
+ * @param       reg_address: 寄存器地址
+ * @param       data: 要写入的数据
+ * @param       len: 要写入的数据长度
+ * @param       ack_mask: 返回全部字节均应答(写入成功)的总线掩码，不需要时传NULL
+ * @param       timeout: 超时时间ms
+ * @retval      0，全部总线写入成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取总线超时；1，至少一条总线失败
+ */
+uint8_t bbus_i2c_broadcast_write(uint32_t lun_mask, uint16_t slave_addr, uint8_t reg_address, const uint8_t *data, uint8_t len, uint32_t *ack_mask, uint32_t timeout);
+
+/* 字节级事务：供协议层(如SMBus)逐字节组织传输，与常规传输函数共用互斥锁、关中断粒度、
+ * 时钟延展检测与错误码；出错后后续收发不再产生时钟，由 bbus_i2c_xfer_close 统一结束 */
+
+/**
+ * @brief       开始一次事务：获取总线互斥锁、按 BBUS_I2C_LOCK_MODE 关中断并清除错误码
+ * @param       lun: I2C总线号
+ * @param       timeout: 超时时间ms
+ * @retval      0，成功；BBUS_I2C_ERR_LOCK_TIMEOUT，获取互斥锁超时；1，总线被其他主机占用
+ */
+uint8_t bbus_i2c_xfer_open(uint8_t lun, uint32_t timeout);
+
+/**
+ * @brief       产生(重复)起始信号
+ * @param       lun: I2C总线号
+ * @retval      无
+ */
+void bbus_i2c_xfer_start(uint8_t lun);
+
+/**
+ * @brief       发送一个字节并读取应答
+ * @param       lun: I2C总线号
+ * @param       data: 要发送的数据
+ * @param       timeout: 等待ACK超时时间ms
+ * @retval      0，应答；1，未应答或此前已出错
+ */
+uint8_t bbus_i2c_xfer_tx(uint8_t lun, uint8_t data, uint32_t timeout);
+
+/**
+ * @brief       接收一个字节并发送ACK/NACK
+ * @param       lun: I2C总线号
+ * @param       ack: ack=1时，发送ack; ack=0时，发送nack
+ * @retval      接收到的数据，此前已出错时返回0xFF
+ */
+uint8_t bbus_i2c_xfer_rx(uint8_t lun, uint8_t ack);
+
+/**
+ * @brief       结束事务：产生停止信号并释放总线
+ * @param       lun: I2C总线号
+ * @retval      0，事务期间无错误；1，有错误，错误码见 bbus_i2c_get_error
+ */
+uint8_t bbus_i2c_xfer_close(uint8_t lun);
+
+/* 线路级操作：供扩展模块自行组织时序使用，经过引脚状态缓存，调用者需先通过 bbus_i2c_lock 独占总线 */
+
+/**
+ * @brief       获取总线半周期延时
+ * @param       lun: I2C总线号
+ * @retval      延时时间 (单位: us)
+ */
+uint32_t bbus_i2c_get_delay_time(uint8_t lun);
+
+/**
+ * @brief       设置SCL电平
+ * @param       lun: I2C总线号
+ * @param       level: 1：释放(高电平)，0：拉低
+ * @retval      无
+ */
+void bbus_i2c_line_scl(uint8_t lun, uint8_t level);
+
+/**
+ * @brief       读取SCL电平，端口不支持 BBUS_I2C_PORT_CAP_SCL_READ 时返回最近一次驱动的电平
+ * @param       lun: I2C总线号
+ * @retval      SCL电平
+ */
+uint8_t bbus_i2c_line_scl_get(uint8_t lun);
+
+/**
+ * @brief       由主机驱动SDA电平
+ * @param       lun: I2C总线号
+ * @param       level: 1：高电平，0：低电平
+ * @retval      无
+ */
+void bbus_i2c_line_sda(uint8_t lun, uint8_t level);
+
+/**
+ * @brief       释放SDA，交由从机驱动
+ * @param       lun: I2C总线号
+ * @retval      无
+ */
+void bbus_i2c_line_sda_release(uint8_t lun);
+
+/**
+ * @brief       读取SDA电平
+ * @param       lun: I2C总线号
+ * @retval      SDA电平
  */
-uint8_t bbus_i2c_read_seq(uint8_t lun, uint8_t slave_addr, uint8_t *data, uint8_t len, uint32_t timeout);
+uint8_t bbus_i2c_line_sda_get(uint8_t lun);
 
 #endif
@@ -52,6 +52,16 @@ uint32_t bbus_i2c_port_tick_get(void)
     return HAL_GetTick();
 }
 
+/**
+ * @brief   获取自由运行的周期计数器，用于统计关中断窗口等时长
+ * @param   无
+ * @retval  当前周期计数
+ */
+uint32_t bbus_i2c_port_cycle_get(void)
+{
+    return DWT->CYCCNT;
+}
+
 /**
  * @brief   软件I2C端口初始化
  * @param   lun: I2C总线号
@@ -59,6 +69,10 @@ uint32_t bbus_i2c_port_tick_get(void)
  */
 void bbus_i2c_port_init(uint8_t lun)
 {
+    /* 开启DWT周期计数器 */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
     switch (lun)
     {
     case 0:
@@ -74,6 +88,34 @@ void bbus_i2c_port_init(uint8_t lun)
     }
 }
 
+/**
+ * @brief   获取端口能力标志
+ * @param   lun: I2C总线号
+ * @retval  BBUS_I2C_PORT_CAP_xxx 的按位组合
+ */
+uint8_t bbus_i2c_port_get_caps(uint8_t lun)
+{
+    uint8_t caps = 0;
+    switch (lun)
+    {
+    case 0:
+        caps = BBUS_I2C_PORT_CAP_OPEN_DRAIN | BBUS_I2C_PORT_CAP_SCL_READ; /* PB6~PB9 配置为开漏输出，可回读引脚电平 */
+#if BBUS_I2C_USE_PUSH_PULL
+        caps |= BBUS_I2C_PORT_CAP_PUSH_PULL; /* 可改写CRL/CRH切换为推挽 */
+#endif
+        break;
+    case 1:
+        caps = BBUS_I2C_PORT_CAP_OPEN_DRAIN | BBUS_I2C_PORT_CAP_SCL_READ; /* PB6~PB9 配置为开漏输出，可回读引脚电平 */
+#if BBUS_I2C_USE_PUSH_PULL
+        caps |= BBUS_I2C_PORT_CAP_PUSH_PULL; /* 可改写CRL/CRH切换为推挽 */
+#endif
+        break;
+    default:
+        break;
+    }
+    return caps;
+}
+
 /**
  * @brief   设置I2C SDA引脚电平
  * @param   lun: I2C总线号
@@ -138,6 +180,46 @@ uint8_t bbus_i2c_port_sda_get(uint8_t lun)
     return ret;
 }
 
+/**
+ * @brief   获取I2C SCL引脚电平
+ * @note    仅在端口能力包含 BBUS_I2C_PORT_CAP_SCL_READ 时被调用
+ * @param   lun: I2C总线号
+ * @retval  SCL引脚电平，1：高电平，0：低电平
+ */
+uint8_t bbus_i2c_port_scl_get(uint8_t lun)
+{
+    uint8_t ret = 0;
+    switch (lun)
+    {
+    case 0:
+        ret = (HAL_GPIO_ReadPin(GPIOB, GPIO_PIN_6) == GPIO_PIN_SET) ? 1 : 0;
+        break;
+    case 1:
+        ret = (HAL_GPIO_ReadPin(GPIOB, GPIO_PIN_8) == GPIO_PIN_SET) ? 1 : 0;
+        break;
+    default:
+        break;
+    }
+    return ret;
+}
+
+#if BBUS_I2C_USE_PUSH_PULL
+/**
+ * @brief   将GPIOB引脚配置为50MHz输出
+ * @param   pin: 引脚编号0~15
+ * @param   open_drain: 1：开漏，0：推挽
+ * @retval  无
+ */
+static void gpiob_set_output(uint8_t pin, uint8_t open_drain)
+{
+    volatile uint32_t *cr = (pin < 8) ? &GPIOB->CRL : &GPIOB->CRH;
+    uint32_t shift = (pin & 7u) * 4u;
+
+    /* MODE=11(50MHz输出)，CNF=00推挽/01开漏 */
+    *cr = (*cr & ~(0xFu << shift)) | ((open_drain ? 0x7u : 0x3u) << shift);
+}
+#endif
+
 /**
  * @brief   设置I2C SDA引脚为输出模式
  * @param   lun: I2C总线号
@@ -148,8 +230,14 @@ void bbus_i2c_port_sda_set_out(uint8_t lun)
     switch (lun)
     {
     case 0:
+#if BBUS_I2C_USE_PUSH_PULL
+        gpiob_set_output(7, 0); /* 仅推挽模式下被调用，开漏模式读写不切换方向 */
+#endif
         break;
     case 1:
+#if BBUS_I2C_USE_PUSH_PULL
+        gpiob_set_output(9, 0); /* 仅推挽模式下被调用，开漏模式读写不切换方向 */
+#endif
         break;
     default:
         break;
@@ -166,13 +254,45 @@ void bbus_i2c_port_sda_set_in(uint8_t lun)
     switch (lun)
     {
     case 0:
+#if BBUS_I2C_USE_PUSH_PULL
+        gpiob_set_output(7, 1); /* 仅推挽模式下被调用，开漏模式读写不切换方向 */
+#endif
+        break;
+    case 1:
+#if BBUS_I2C_USE_PUSH_PULL
+        gpiob_set_output(9, 1); /* 仅推挽模式下被调用，开漏模式读写不切换方向 */
+#endif
+        break;
+    default:
+        break;
+    }
+}
+
+#if BBUS_I2C_USE_PUSH_PULL
+/**
+ * @brief   切换I2C引脚驱动方式
+ * @param   lun: I2C总线号
+ * @param   push_pull: 1：推挽，0：恢复开漏
+ * @retval  无
+ */
+void bbus_i2c_port_set_drive(uint8_t lun, uint8_t push_pull)
+{
+    /* SDA先回到开漏释放状态，由核心在下一次发送前切换为推挽 */
+    switch (lun)
+    {
+    case 0:
+        gpiob_set_output(6, !push_pull);
+        gpiob_set_output(7, 1);
         break;
     case 1:
+        gpiob_set_output(8, !push_pull);
+        gpiob_set_output(9, 1);
         break;
     default:
         break;
     }
 }
+#endif
 
 /**
  * @brief   进入临界区
@@ -209,3 +329,105 @@ void bbus_i2c_port_exit_critical(uint8_t lun)
         break;
     }
 }
+
+/**
+ * @brief   获取总线互斥锁，保证一次传输期间总线被独占
+ * @note    互斥锁必须可递归获取，以支持 bbus_i2c_lock 包裹多次传输
+ * @param   lun: I2C总线号
+ * @param   timeout: 超时时间ms，BBUS_I2C_WAIT_FOREVER 表示永久等待
+ * @retval  0，获取成功；1，获取超时
+ */
+uint8_t bbus_i2c_port_mutex_take(uint8_t lun, uint32_t timeout)
+{
+    uint8_t ret = 0;
+    switch (lun)
+    {
+    case 0:
+        break;
+    case 1:
+        break;
+    default:
+        break;
+    }
+    return ret;
+}
+
+/**
+ * @brief   释放总线互斥锁
+ * @param   lun: I2C总线号
+ * @retval  无
+ */
+void bbus_i2c_port_mutex_give(uint8_t lun)
+{
+    switch (lun)
+    {
+    case 0:
+        break;
+    case 1:
+        break;
+    default:
+        break;
+    }
+}
+
+#if BBUS_I2C_USE_PORT_MASK
+/* 两条总线的引脚都在GPIOB上，通过BSRR一次写入多个引脚 */
+static const uint16_t scl_pin[BBUS_I2C_BUS_NUM] = {GPIO_PIN_6, GPIO_PIN_8};
+static const uint16_t sda_pin[BBUS_I2C_BUS_NUM] = {GPIO_PIN_7, GPIO_PIN_9};
+
+static uint32_t pins_of(const uint16_t *pin, uint32_t mask)
+{
+    uint32_t pins = 0;
+    for (uint8_t i = 0; i < BBUS_I2C_BUS_NUM; i++)
+    {
+        if (mask & (1u << i))
+        {
+            pins |= pin[i];
+        }
+    }
+    return pins;
+}
+
+/**
+ * @brief   同时设置多条总线的SCL引脚电平
+ * @param   mask: 总线掩码，第n位对应总线n
+ * @param   level: SCL引脚电平，1：高电平，0：低电平
+ * @retval  无
+ */
+void bbus_i2c_port_scl_set_mask(uint32_t mask, uint8_t level)
+{
+    uint32_t pins = pins_of(scl_pin, mask);
+    GPIOB->BSRR = (level == 1) ? pins : (pins << 16);
+}
+
+/**
+ * @brief   同时设置多条总线的SDA引脚电平
+ * @param   mask: 总线掩码，第n位对应总线n
+ * @param   level: SDA引脚电平，1：高电平，0：低电平
+ * @retval  无
+ */
+void bbus_i2c_port_sda_set_mask(uint32_t mask, uint8_t level)
+{
+    uint32_t pins = pins_of(sda_pin, mask);
+    GPIOB->BSRR = (level == 1) ? pins : (pins << 16);
+}
+
+/**
+ * @brief   同时读取多条总线的SDA引脚电平
+ * @param   mask: 总线掩码，第n位对应总线n
+ * @retval  各总线SDA电平，第n位对应总线n
+ */
+uint32_t bbus_i2c_port_sda_get_mask(uint32_t mask)
+{
+    uint32_t idr = GPIOB->IDR;
+    uint32_t ret = 0;
+    for (uint8_t i = 0; i < BBUS_I2C_BUS_NUM; i++)
+    {
+        if ((mask & (1u << i)) && (idr & sda_pin[i]))
+        {
+            ret |= 1u << i;
+        }
+    }
+    return ret;
+}
+#endif
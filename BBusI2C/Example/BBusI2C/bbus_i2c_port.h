@@ -35,7 +35,83 @@
 
 #define BBUS_I2C_LOG(...) printf(__VA_ARGS__)
 
+#ifndef BBUS_I2C_BUS_NUM /* 主机测试程序可在编译命令中用 -D 覆盖，下同 */
 #define BBUS_I2C_BUS_NUM 2 // 总共支持的 I2C 总线数量
+#endif
+
+#define BBUS_I2C_USE_STATS 1 // 是否开启总线统计计数（端口调用次数等），0：关闭，1：开启
+
+/* 操作系统适配：用于实现总线互斥锁(bbus_i2c_port_mutex_take/give) */
+#define BBUS_I2C_OS_NONE     0 // 裸机，不使用互斥锁
+#define BBUS_I2C_OS_FREERTOS 1 // FreeRTOS 递归互斥量(带优先级继承)
+#define BBUS_I2C_OS_POSIX    2 // POSIX 线程递归互斥锁(PTHREAD_PRIO_INHERIT)，可在Linux上测试
+#ifndef BBUS_I2C_OS
+#define BBUS_I2C_OS BBUS_I2C_OS_NONE // 选择操作系统适配
+#endif
+
+#define BBUS_I2C_WAIT_FOREVER 0xFFFFFFFFu // 互斥锁超时参数：永久等待
+
+#ifndef BBUS_I2C_CYCLES_PER_US
+#define BBUS_I2C_CYCLES_PER_US 72 // bbus_i2c_port_cycle_get 每微秒的计数值(如72MHz内核为72，POSIX实现以纳秒计为1000)
+#endif
+
+/* 关中断粒度：事务级在整个传输期间关中断(从机未立即应答、按系统时间等待ACK时临时开中断)；字节级仅在每个字节(9个时钟)内关中断；
+ * 不关中断时由 bbus_i2c_port_mutex_take/give 保证总线独占 */
+#define BBUS_I2C_LOCK_TRANSACTION 0
+#define BBUS_I2C_LOCK_BYTE        1
+#define BBUS_I2C_LOCK_NONE        2
+#define BBUS_I2C_LOCK_MODE BBUS_I2C_LOCK_TRANSACTION // 选择关中断粒度
+
+#define BBUS_I2C_CACHE_LINE 0 // 每条总线的状态按缓存行大小对齐(如64)，多核/多线程下避免伪共享，0：不对齐
+
+#if BBUS_I2C_CACHE_LINE
+#define BBUS_I2C_ALIGNED __attribute__((aligned(BBUS_I2C_CACHE_LINE)))
+#else
+#define BBUS_I2C_ALIGNED
+#endif
+
+/* 多主机：发送每个数据位时回读SDA检测仲裁失败，起始信号前确认总线空闲，失败的传输退避后自动重试。
+ * 要求端口为开漏输出(BBUS_I2C_PORT_CAP_OPEN_DRAIN)，并支持回读SCL以实现时钟同步 */
+#define BBUS_I2C_USE_MULTI_MASTER 0  // 是否开启多主机支持，0：关闭，1：开启
+#define BBUS_I2C_BUS_FREE_US      5  // 起始信号前SCL/SDA须同时保持高电平的最短时间(us)，另加一个SCL周期
+#define BBUS_I2C_ARB_RETRIES      3  // 仲裁失败后自动重试的次数
+#define BBUS_I2C_IDLE_TIMEOUT     10 // bbus_i2c_start 等待总线空闲的超时时间ms
+
+/* 多总线执行器(bbus_i2c_exec.c)：每条总线一个工作线程，请求经无锁队列提交，需要C11 <stdatomic.h> */
+#ifndef BBUS_I2C_USE_EXEC
+#define BBUS_I2C_USE_EXEC       0   // 是否启用执行器，0：关闭，1：开启
+#endif
+#define BBUS_I2C_EXEC_QUEUE_LEN 16  // 每条总线的请求队列长度，必须为2的幂
+#define BBUS_I2C_EXEC_IDLE_US   100 // 工作线程队列为空时的休眠时间(us)
+
+/* 多总线同步写(bbus_i2c_broadcast_write)：多条总线的引脚位于同一GPIO端口时，
+ * 可由端口提供按总线掩码一次写入/读取的函数，关闭时逐条总线调用单引脚函数 */
+#define BBUS_I2C_USE_PORT_MASK 1 // 是否提供 bbus_i2c_port_xxx_mask 函数，0：不提供，1：提供
+
+/* 推挽驱动(bbus_i2c_set_push_pull)：单主机、从机不做时钟延展的总线上，SCL改为推挽输出，
+ * SDA仅在主机驱动时推挽，应答和读数据阶段切回开漏/输入，可省去上拉电阻的上升沿时间 */
+#define BBUS_I2C_USE_PUSH_PULL 1 // 是否提供 bbus_i2c_port_set_drive 函数，0：不提供，1：提供
+
+/* 上升时间补偿：释放SCL后用 bbus_i2c_port_cycle_get 计时回读SCL，估计上拉电阻与线路电容造成的上升时间，
+ * 未开启时钟延展检测的总线在每个SCL高电平额外等待该时间，使实际高电平不短于半周期延时。
+ * 需要端口支持 BBUS_I2C_PORT_CAP_SCL_READ */
+#define BBUS_I2C_USE_RISE_COMP 1    // 是否开启上升时间测量与补偿，0：关闭，1：开启
+#define BBUS_I2C_RISE_PERIOD   1000 // 传输开始前自动重新测量的间隔ms，0：仅在初始化与调用 bbus_i2c_measure_rise 时测量
+#define BBUS_I2C_RISE_MAX_US   20   // 上升时间测量上限(us)，超过视为SCL被拉住或缺少上拉电阻
+
+/* 速率调节器(bbus_i2c_gov.c)：按设备统计错误率自动调节半周期延时 */
+#define BBUS_I2C_GOV_HISTORY_LEN 8 // 每个调节器保留的最近调速记录条数
+
+/* 读合并(bbus_i2c_coal.c)：同一设备相邻/重叠的读请求合并为一次连续读 */
+#define BBUS_I2C_COAL_MAX_BURST 32 // 合并后单次连续读的最大字节数
+
+/* 事件驱动读取(bbus_i2c_event.c)：DRDY/INT/SMBALERT#中断触发的读取 */
+#define BBUS_I2C_EVENT_ARA_MAX 8 // 一次SMBALERT#处理中最多查询报警响应地址的次数
+
+/* 端口能力标志，由 bbus_i2c_port_get_caps 返回，可按位组合 */
+#define BBUS_I2C_PORT_CAP_OPEN_DRAIN (1u << 0) // SDA为开漏输出，读写无需切换引脚方向
+#define BBUS_I2C_PORT_CAP_SCL_READ   (1u << 1) // 支持回读SCL电平(bbus_i2c_port_scl_get)，可检测时钟延展
+#define BBUS_I2C_PORT_CAP_PUSH_PULL  (1u << 2) // 支持切换为推挽驱动(bbus_i2c_port_set_drive)
 
 /**
  * @brief   软件I2C端口初始化
@@ -44,6 +120,13 @@
  */
 void bbus_i2c_port_init(uint8_t lun);
 
+/**
+ * @brief   获取端口能力标志
+ * @param   lun: I2C总线号
+ * @retval  BBUS_I2C_PORT_CAP_xxx 的按位组合
+ */
+uint8_t bbus_i2c_port_get_caps(uint8_t lun);
+
 /**
  * @brief   软件I2C延时函数
  * @param   xus: 延时时间，单位us
@@ -58,6 +141,15 @@ void bbus_i2c_port_delay_us(uint32_t xus);
  */
 uint32_t bbus_i2c_port_tick_get(void);
 
+/**
+ * @brief   获取自由运行的周期计数器，用于统计关中断窗口等时长
+ * @note    可对接DWT->CYCCNT等硬件计数器，不需要时返回0即可；
+ *          使用 bbus_i2c_multi 时必须实现，该模块的全部延时基于此计数器，返回0时拒绝执行
+ * @param   无
+ * @retval  当前周期计数
+ */
+uint32_t bbus_i2c_port_cycle_get(void);
+
 /**
  * @brief   设置I2C SDA引脚电平
  * @param   lun: I2C总线号
@@ -81,6 +173,14 @@ void bbus_i2c_port_scl_set(uint8_t lun, uint8_t level);
  */
 uint8_t bbus_i2c_port_sda_get(uint8_t lun);
 
+/**
+ * @brief   获取I2C SCL引脚电平
+ * @note    仅在端口能力包含 BBUS_I2C_PORT_CAP_SCL_READ 时被调用
+ * @param   lun: I2C总线号
+ * @retval  SCL引脚电平，1：高电平，0：低电平
+ */
+uint8_t bbus_i2c_port_scl_get(uint8_t lun);
+
 /**
  * @brief   设置I2C SDA引脚为输出模式
  * @param   lun: I2C总线号
@@ -95,6 +195,18 @@ void bbus_i2c_port_sda_set_out(uint8_t lun);
  */
 void bbus_i2c_port_sda_set_in(uint8_t lun);
 
+#if BBUS_I2C_USE_PUSH_PULL
+/**
+ * @brief   切换I2C引脚驱动方式
+ * @note    仅在端口能力包含 BBUS_I2C_PORT_CAP_PUSH_PULL 时被调用；推挽时SCL为推挽输出，
+ *          SDA由 bbus_i2c_port_sda_set_out/bbus_i2c_port_sda_set_in 在推挽输出与开漏/输入之间切换
+ * @param   lun: I2C总线号
+ * @param   push_pull: 1：推挽，0：恢复开漏
+ * @retval  无
+ */
+void bbus_i2c_port_set_drive(uint8_t lun, uint8_t push_pull);
+#endif
+
 /**
  * @brief   进入临界区
  * @param   lun: I2C总线号
@@ -109,4 +221,45 @@ void bbus_i2c_port_enter_critical(uint8_t lun);
  */
 void bbus_i2c_port_exit_critical(uint8_t lun);
 
+/**
+ * @brief   获取总线互斥锁，保证一次传输期间总线被独占
+ * @note    互斥锁必须可递归获取，以支持 bbus_i2c_lock 包裹多次传输
+ * @param   lun: I2C总线号
+ * @param   timeout: 超时时间ms，BBUS_I2C_WAIT_FOREVER 表示永久等待
+ * @retval  0，获取成功；1，获取超时
+ */
+uint8_t bbus_i2c_port_mutex_take(uint8_t lun, uint32_t timeout);
+
+/**
+ * @brief   释放总线互斥锁
+ * @param   lun: I2C总线号
+ * @retval  无
+ */
+void bbus_i2c_port_mutex_give(uint8_t lun);
+
+#if BBUS_I2C_USE_PORT_MASK
+/**
+ * @brief   同时设置多条总线的SCL引脚电平
+ * @param   mask: 总线掩码，第n位对应总线n
+ * @param   level: SCL引脚电平，1：高电平，0：低电平
+ * @retval  无
+ */
+void bbus_i2c_port_scl_set_mask(uint32_t mask, uint8_t level);
+
+/**
+ * @brief   同时设置多条总线的SDA引脚电平
+ * @param   mask: 总线掩码，第n位对应总线n
+ * @param   level: SDA引脚电平，1：高电平，0：低电平
+ * @retval  无
+ */
+void bbus_i2c_port_sda_set_mask(uint32_t mask, uint8_t level);
+
+/**
+ * @brief   同时读取多条总线的SDA引脚电平
+ * @param   mask: 总线掩码，第n位对应总线n
+ * @retval  各总线SDA电平，第n位对应总线n
+ */
+uint32_t bbus_i2c_port_sda_get_mask(uint32_t mask);
+#endif
+
 #endif
@@ -0,0 +1,141 @@
+/**
+ * @file    exec_bench.c
+ * @version v1.0
+ * @date    2026-10-19
+ * @author  ZeroOneLab
+ * @website https://github.com/ZeroOneLab/BBusI2C.git
+ *
+ * @license MIT License
+ * Copyright (c) 2026 ZeroOneLab
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * 执行器吞吐量基准：用 Core 中 POSIX 端口(引脚函数为空，从机恒应答，延时为真实休眠)，
+ * 把同样数量的读请求分摊到 1..BBUS_I2C_BUS_NUM 条总线上，比较总耗时与每秒完成的传输数。
+ * 总线之间由各自的工作线程并行执行，理想情况下吞吐量随总线数线性增长。
+ *
+ * 在 BBusI2C/Test 目录下编译运行：
+ * gcc -std=c11 -O2 -Wall -D_GNU_SOURCE -DBBUS_I2C_OS=2 -DBBUS_I2C_USE_EXEC=1 -DBBUS_I2C_BUS_NUM=4 -DBBUS_I2C_CYCLES_PER_US=1000 -I../Core -o exec_bench ../Core/bbus_i2c.c ../Core/bbus_i2c_exec.c ../Core/bbus_i2c_port.c exec_bench.c -lpthread && ./exec_bench
+ */
+
+#include <stdio.h>
+#include <time.h>
+
+#include "bbus_i2c_exec.h"
+
+#if !BBUS_I2C_USE_EXEC || (BBUS_I2C_OS != BBUS_I2C_OS_POSIX)
+#error "exec_bench needs -DBBUS_I2C_USE_EXEC=1 -DBBUS_I2C_OS=2"
+#endif
+
+#define BENCH_REQS 256 /* 每轮请求总数 */
+#define BENCH_LEN  4   /* 每次读取的字节数 */
+
+static bbus_i2c_req_t reqs[BENCH_REQS];
+static uint8_t bufs[BENCH_REQS][BENCH_LEN];
+
+static double bench_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * @brief       把 BENCH_REQS 个请求轮流提交到前 buses 条总线并等待全部完成
+ * @param       buses: 使用的总线数
+ * @retval      耗时(s)，出错返回负数
+ */
+static double bench_run(uint8_t buses)
+{
+    double t0 = bench_now();
+    uint32_t i = 0, done = 0;
+
+    while (done < BENCH_REQS)
+    {
+        /* 队列满时先等待最早的请求完成，再继续提交 */
+        if (i < BENCH_REQS)
+        {
+            bbus_i2c_req_t *r = &reqs[i];
+
+            r->op = BBUS_I2C_EXEC_OP_READ;
+            r->lun = (uint8_t)(i % buses);
+            r->slave_addr = 0xA0;
+            r->reg_address = (uint8_t)i;
+            r->data = bufs[i];
+            r->len = BENCH_LEN;
+            r->timeout = 100;
+            r->cb = 0;
+            if (bbus_i2c_exec_submit(r) == 0)
+            {
+                i++;
+                continue;
+            }
+        }
+        if (bbus_i2c_exec_wait(&reqs[done], BBUS_I2C_WAIT_FOREVER))
+        {
+            return -1;
+        }
+        done++;
+    }
+    return bench_now() - t0;
+}
+
+int main(void)
+{
+    bbus_i2c_exec_stats_t stats;
+    double base = 0;
+
+    bbus_i2c_init();
+    bbus_i2c_exec_init();
+    if (bbus_i2c_exec_start())
+    {
+        return 1;
+    }
+
+    printf("%d reads of %d bytes per run\n", BENCH_REQS, BENCH_LEN);
+    printf("buses  time(ms)  xfer/s  speedup\n");
+    for (uint8_t buses = 1; buses <= BBUS_I2C_BUS_NUM; buses++)
+    {
+        double t = bench_run(buses);
+
+        if (t < 0)
+        {
+            printf("bus error\n");
+            bbus_i2c_exec_join();
+            return 1;
+        }
+        if (buses == 1)
+        {
+            base = t;
+        }
+        printf("%5d  %8.1f  %6.0f  %6.2fx\n", buses, t * 1e3, BENCH_REQS / t, base / t);
+    }
+    bbus_i2c_exec_join();
+
+    for (uint8_t lun = 0; lun < BBUS_I2C_BUS_NUM; lun++)
+    {
+        bbus_i2c_exec_get_stats(lun, &stats);
+        printf("bus %d: completed %u, rejected %u, busy %llu us\n", lun, (unsigned)stats.completed, (unsigned)stats.rejected,
+               (unsigned long long)(stats.busy_cycles / BBUS_I2C_CYCLES_PER_US));
+    }
+    return 0;
+}
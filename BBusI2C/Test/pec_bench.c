@@ -0,0 +1,117 @@
+/**
+ * @file    pec_bench.c
+ * @version v1.0
+ * @date    2026-10-19
+ * @author  ZeroOneLab
+ * @website https://github.com/ZeroOneLab/BBusI2C.git
+ *
+ * @license MIT License
+ * Copyright (c) 2026 ZeroOneLab
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * PEC计算开销基准：比较 bbus_i2c_smbus_pec 的查表实现与逐位移位的CRC-8参考实现，
+ * 先校验两者结果一致，再分别对同一缓冲区反复计算，输出每字节耗时(ns)。
+ *
+ * 在 BBusI2C/Test 目录下编译运行：
+ * gcc -std=c11 -O2 -Wall -D_GNU_SOURCE -DBBUS_I2C_OS=2 -I../Core -o pec_bench ../Core/bbus_i2c.c ../Core/bbus_i2c_smbus.c ../Core/bbus_i2c_port.c pec_bench.c -lpthread && ./pec_bench
+ */
+
+#include <stdio.h>
+#include <time.h>
+
+#include "bbus_i2c_smbus.h"
+
+#define BENCH_LEN    255    /* 单次计算的字节数(bbus_i2c_smbus_pec 的长度上限) */
+#define BENCH_ROUNDS 100000 /* 每种实现的重复次数 */
+
+static uint8_t data[BENCH_LEN];
+static volatile uint8_t sink; /* 防止计算被优化掉 */
+
+/**
+ * @brief       逐位计算CRC-8(多项式 x^8+x^2+x+1)，每字节8次移位与条件异或
+ * @param       pec: 前一段的PEC，首段为0
+ * @param       buf: 数据
+ * @param       len: 数据长度
+ * @retval      累加后的PEC
+ */
+static uint8_t pec_bitwise(uint8_t pec, const uint8_t *buf, uint8_t len)
+{
+    for (uint8_t i = 0; i < len; i++)
+    {
+        pec ^= buf[i];
+        for (uint8_t j = 0; j < 8; j++)
+        {
+            pec = (pec & 0x80) ? (uint8_t)((pec << 1) ^ 0x07) : (uint8_t)(pec << 1);
+        }
+    }
+    return pec;
+}
+
+static double bench_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(void)
+{
+    double t0, table_ns, bitwise_ns;
+    uint8_t pec;
+
+    for (uint32_t i = 0; i < BENCH_LEN; i++)
+    {
+        data[i] = (uint8_t)(i * 37u + 11u);
+    }
+    for (uint8_t len = 0; len < BENCH_LEN; len++)
+    {
+        if (bbus_i2c_smbus_pec(0, data, len) != pec_bitwise(0, data, len))
+        {
+            printf("PEC mismatch at length %d\n", len);
+            return 1;
+        }
+    }
+
+    pec = 0;
+    t0 = bench_now();
+    for (uint32_t r = 0; r < BENCH_ROUNDS; r++)
+    {
+        pec = bbus_i2c_smbus_pec(pec, data, BENCH_LEN);
+    }
+    table_ns = (bench_now() - t0) * 1e9 / ((double)BENCH_ROUNDS * BENCH_LEN);
+    sink = pec;
+
+    pec = 0;
+    t0 = bench_now();
+    for (uint32_t r = 0; r < BENCH_ROUNDS; r++)
+    {
+        pec = pec_bitwise(pec, data, BENCH_LEN);
+    }
+    bitwise_ns = (bench_now() - t0) * 1e9 / ((double)BENCH_ROUNDS * BENCH_LEN);
+    sink = pec;
+
+    printf("table:   %.2f ns/byte\n", table_ns);
+    printf("bitwise: %.2f ns/byte\n", bitwise_ns);
+    printf("speedup: %.1fx\n", bitwise_ns / table_ns);
+    return 0;
+}
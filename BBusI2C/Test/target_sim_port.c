@@ -0,0 +1,197 @@
+/**
+ * @file    target_sim_port.c
+ * @version v1.0
+ * @date    2026-10-19
+ * @author  ZeroOneLab
+ * @website https://github.com/ZeroOneLab/BBusI2C.git
+ *
+ * @license MIT License
+ * Copyright (c) 2026 ZeroOneLab
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * 主机仿真端口：0号总线为主机引脚，1号总线为从机(bbus_i2c_target)引脚，两者接在同一对线与总线上。
+ * 任一引脚电平变化后按边沿调用从机的SCL/SDA中断处理函数，模拟双边沿外部中断。
+ */
+
+#include "target_sim.h"
+
+static uint8_t pin_scl[2] = {1, 1};
+static uint8_t pin_sda[2] = {1, 1};
+static uint8_t line_scl = 1, line_sda = 1; /* 中断处理函数最近一次看到的线路电平 */
+static uint8_t in_isr;                     /* 中断处理中，引脚变化不再嵌套触发 */
+static uint8_t target_edge;                /* 本次SDA变化由从机引擎驱动 */
+static uint8_t sda_pending;                /* 被推迟的SDA中断 */
+static uint32_t sim_us;
+
+bbus_i2c_target_t *sim_target;
+uint8_t sim_late_sda;
+
+static uint8_t sim_scl(void)
+{
+    return pin_scl[0] & pin_scl[1];
+}
+
+static uint8_t sim_sda(void)
+{
+    return pin_sda[0] & pin_sda[1];
+}
+
+/**
+ * @brief       按线路电平变化依次调用从机中断处理函数
+ * @note        sim_late_sda为1时，从机自身驱动SDA产生的中断推迟到下一次SCL边沿之后执行，模拟中断响应延迟
+ * @param       无
+ * @retval      无
+ */
+static void sim_eval(void)
+{
+    uint8_t scl, sda;
+
+    if (in_isr || !sim_target)
+    {
+        return;
+    }
+    in_isr = 1;
+    for (;;)
+    {
+        scl = sim_scl();
+        sda = sim_sda();
+        if (scl != line_scl)
+        {
+            line_scl = scl;
+            bbus_i2c_target_scl_isr(sim_target);
+            if (sda_pending)
+            {
+                sda_pending = 0;
+                bbus_i2c_target_sda_isr(sim_target);
+            }
+            continue;
+        }
+        if (sda != line_sda)
+        {
+            line_sda = sda;
+            if (sda_pending)
+            {
+                continue; // 挂起的中断尚未执行，同一引脚的后续边沿合并为一次
+            }
+            if (sim_late_sda && target_edge)
+            {
+                target_edge = 0;
+                sda_pending = 1;
+                continue;
+            }
+            bbus_i2c_target_sda_isr(sim_target);
+            continue;
+        }
+        break;
+    }
+    target_edge = 0;
+    in_isr = 0;
+}
+
+uint8_t bbus_i2c_port_get_caps(uint8_t lun)
+{
+    (void)lun;
+    return BBUS_I2C_PORT_CAP_OPEN_DRAIN | BBUS_I2C_PORT_CAP_SCL_READ;
+}
+
+void bbus_i2c_port_init(uint8_t lun)
+{
+    pin_scl[lun] = 1;
+    pin_sda[lun] = 1;
+}
+
+void bbus_i2c_port_delay_us(uint32_t xus)
+{
+    sim_us += xus;
+}
+
+uint32_t bbus_i2c_port_tick_get(void)
+{
+    sim_us += 10;
+    return sim_us / 1000;
+}
+
+uint32_t bbus_i2c_port_cycle_get(void)
+{
+    sim_us++;
+    return sim_us * 72;
+}
+
+void bbus_i2c_port_scl_set(uint8_t lun, uint8_t level)
+{
+    pin_scl[lun] = level;
+    sim_eval();
+}
+
+void bbus_i2c_port_sda_set(uint8_t lun, uint8_t level)
+{
+    if (in_isr && pin_sda[lun] != level)
+    {
+        target_edge = 1;
+    }
+    pin_sda[lun] = level;
+    sim_eval();
+}
+
+uint8_t bbus_i2c_port_scl_get(uint8_t lun)
+{
+    (void)lun;
+    return sim_scl();
+}
+
+uint8_t bbus_i2c_port_sda_get(uint8_t lun)
+{
+    (void)lun;
+    return sim_sda();
+}
+
+void bbus_i2c_port_sda_set_out(uint8_t lun)
+{
+    (void)lun;
+}
+
+void bbus_i2c_port_sda_set_in(uint8_t lun)
+{
+    (void)lun;
+}
+
+void bbus_i2c_port_enter_critical(uint8_t lun)
+{
+    (void)lun;
+}
+
+void bbus_i2c_port_exit_critical(uint8_t lun)
+{
+    (void)lun;
+}
+
+uint8_t bbus_i2c_port_mutex_take(uint8_t lun, uint32_t timeout)
+{
+    (void)lun;
+    (void)timeout;
+    return 0;
+}
+
+void bbus_i2c_port_mutex_give(uint8_t lun)
+{
+    (void)lun;
+}
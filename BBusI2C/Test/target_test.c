@@ -0,0 +1,132 @@
+/**
+ * @file    target_test.c
+ * @version v1.0
+ * @date    2026-10-19
+ * @author  ZeroOneLab
+ * @website https://github.com/ZeroOneLab/BBusI2C.git
+ *
+ * @license MIT License
+ * Copyright (c) 2026 ZeroOneLab
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * 从机模式主机仿真测试：用核心层的主机函数访问同一仿真总线上的 bbus_i2c_target，
+ * 分别在SDA中断及时响应与延迟到SCL变高后响应两种情况下运行。
+ *
+ * 在 BBusI2C/Test 目录下编译运行：
+ * gcc -std=c99 -Wall -I../Core -o target_test ../Core/bbus_i2c.c ../Core/bbus_i2c_target.c target_sim_port.c target_test.c && ./target_test
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "target_sim.h"
+
+#define CHECK(cond)                                           \
+    do                                                        \
+    {                                                         \
+        if (!(cond))                                          \
+        {                                                     \
+            printf("FAIL: %s (line %d)\n", #cond, __LINE__); \
+            return 1;                                         \
+        }                                                     \
+    } while (0)
+
+static bbus_i2c_target_t target;
+static uint8_t regs[16];
+static uint8_t done_count, done_reg, done_len;
+
+static void target_done(bbus_i2c_target_t *t, uint8_t reg, uint8_t len)
+{
+    (void)t;
+    done_count++;
+    done_reg = reg;
+    done_len = len;
+}
+
+static uint8_t target_read(bbus_i2c_target_t *t, uint8_t reg)
+{
+    (void)t;
+    return (uint8_t)(0x40 + reg);
+}
+
+static uint8_t run(void)
+{
+    const uint8_t lun = SIM_MASTER_LUN;
+    uint8_t w[3] = {0x11, 0x22, 0x33};
+    uint8_t r[4] = {0};
+
+    memset(regs, 0, sizeof(regs));
+    done_count = 0;
+    CHECK(bbus_i2c_target_init(&target, SIM_TARGET_LUN, 0x84, regs, sizeof(regs)) == 0);
+    bbus_i2c_target_set_callback(&target, 0, 0, target_done, 0);
+    sim_target = &target;
+    bbus_i2c_set_delay_time(lun, 1);
+
+    CHECK(bbus_i2c_check_address(lun, 0x84, 10) == 0);
+    CHECK(bbus_i2c_check_address(lun, 0x86, 10) == 1);
+
+    /* 写入：第一个字节为寄存器指针，停止信号时调用结束回调 */
+    CHECK(bbus_i2c_write_data(lun, 0x84, 0x02, w, 3, 10) == 0);
+    CHECK(regs[2] == 0x11 && regs[3] == 0x22 && regs[4] == 0x33);
+    CHECK(done_count == 1 && done_reg == 0x02 && done_len == 3);
+
+    /* 读取：重复起始后从写入的指针开始，读取不触发结束回调 */
+    CHECK(bbus_i2c_read_data(lun, 0x84, 0x03, r, 3, 10) == 0);
+    CHECK(r[0] == 0x22 && r[1] == 0x33 && r[2] == 0x00);
+    CHECK(done_count == 1);
+
+    /* 无寄存器地址的顺序读取：指针接着上次读取继续 */
+    CHECK(bbus_i2c_read_seq(lun, 0x84, r, 2, 10) == 0);
+    CHECK(r[0] == regs[6] && r[1] == regs[7]);
+
+    /* 读取回调 */
+    bbus_i2c_target_set_callback(&target, target_read, 0, target_done, 0);
+    CHECK(bbus_i2c_read_data(lun, 0x84, 0x05, r, 4, 10) == 0);
+    CHECK(r[0] == 0x45 && r[3] == 0x48);
+
+    /* 较慢的总线时序 */
+    bbus_i2c_set_delay_time(lun, 3);
+    CHECK(bbus_i2c_read_reg(lun, 0x84, 0x01, 1, r, 2, 10) == 0);
+    CHECK(r[0] == 0x41 && r[1] == 0x42);
+
+    sim_target = 0;
+    return 0;
+}
+
+int main(void)
+{
+    bbus_i2c_init();
+
+    sim_late_sda = 0;
+    if (run())
+    {
+        return 1;
+    }
+    sim_late_sda = 1;
+    if (run())
+    {
+        printf("(SDA interrupt delayed)\n");
+        return 1;
+    }
+    printf("target test OK\n");
+    return 0;
+}